@@ -0,0 +1,128 @@
+#include "robokit/config.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// robokit_config_bench: Config::load_file on generated key=value files (two
+// entries and a comment per joint) and get_number lookups against them.
+// Each case reports the best-of-N load time, the load rate in MB/s and the
+// lookup cost; --max-load-ms fails the run if the largest load is slower.
+//
+//   robokit_config_bench [--quick] [--out results.json] [--max-load-ms 1000]
+
+using namespace robokit;
+
+namespace {
+
+struct CaseResult {
+    std::size_t joints{}, bytes{}, entries{};
+    double load_ns{}, lookup_ns{};
+    bool ok{};
+};
+
+std::string write_config(std::size_t joints) {
+    const auto path = std::filesystem::temp_directory_path() / ("robokit_config_bench_" + std::to_string(joints) + ".cfg");
+    std::ofstream out(path, std::ios::binary);
+    for (std::size_t i = 0; i < joints; ++i)
+        out << "joint" << i << ".gain = " << static_cast<double>(i) * 0.5 << "\n# note\nlabel" << i << "=x\n";
+    return path.string();
+}
+
+CaseResult config_case(std::size_t joints, int repeats) {
+    CaseResult r{joints};
+    const std::string path = write_config(joints);
+    r.bytes = static_cast<std::size_t>(std::filesystem::file_size(path));
+    using clock = std::chrono::steady_clock;
+    Config cfg;
+    r.ok = true;
+    for (int rep = 0; rep < repeats; ++rep) {
+        const auto t0 = clock::now();
+        r.ok = cfg.load_file(path) && r.ok;
+        const double ns = std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+        if (rep == 0 || ns < r.load_ns) r.load_ns = ns;
+    }
+    r.entries = cfg.size();
+    r.ok = r.ok && r.entries == 2 * joints;
+
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < joints; i += 7) keys.push_back("joint" + std::to_string(i) + ".gain");
+    double sum = 0;
+    const auto t0 = clock::now();
+    for (int rep = 0; rep < 10; ++rep)
+        for (const auto& k : keys) sum += cfg.get_number(k, -1.0);
+    r.lookup_ns = std::chrono::duration<double, std::nano>(clock::now() - t0).count() / (10.0 * static_cast<double>(keys.size()));
+    r.ok = r.ok && sum >= 0;
+    std::filesystem::remove(path);
+    return r;
+}
+
+std::string to_json(const CaseResult& r) {
+    char buf[256];
+    std::snprintf(buf, sizeof buf,
+                  "{\"name\": \"load/%zu\", \"bytes\": %zu, \"entries\": %zu, \"load_ns\": %.0f, \"mb_per_s\": %.1f, "
+                  "\"lookup_ns\": %.1f}",
+                  r.joints, r.bytes, r.entries, r.load_ns,
+                  r.load_ns > 0 ? static_cast<double>(r.bytes) / r.load_ns * 1e3 : 0.0, r.lookup_ns);
+    return buf;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool quick = false;
+    std::string out_path;
+    double max_load_ms = 0.0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--quick") quick = true;
+        else if (a == "--out" && i + 1 < argc) out_path = argv[++i];
+        else if (a == "--max-load-ms" && i + 1 < argc) max_load_ms = std::strtod(argv[++i], nullptr);
+        else {
+            std::cerr << "usage: " << argv[0] << " [--quick] [--out results.json] [--max-load-ms 1000]\n";
+            return 2;
+        }
+    }
+
+    const int repeats = quick ? 1 : 5;
+    std::vector<CaseResult> results;
+    for (std::size_t n : quick ? std::vector<std::size_t>{1000, 10'000} : std::vector<std::size_t>{10'000, 100'000, 1'000'000})
+        results.push_back(config_case(n, repeats));
+
+    int failures = 0;
+    for (const auto& r : results) {
+        std::cerr << to_json(r) << '\n';
+        if (!r.ok) {
+            std::cerr << "LOAD FAILED " << r.joints << '\n';
+            ++failures;
+        }
+    }
+    // only the largest file carries the time limit
+    if (max_load_ms > 0 && results.back().load_ns > max_load_ms * 1e6) {
+        std::cerr << "ABOVE LIMIT load/" << results.back().joints << ": " << results.back().load_ns / 1e6 << " ms\n";
+        ++failures;
+    }
+
+    std::ostringstream json;
+    json << "{\n\"robokit_version\": \"" << ROBOKIT_VERSION << "\",\n\"quick\": " << (quick ? "true" : "false")
+         << ",\n\"cases\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i)
+        json << to_json(results[i]) << (i + 1 < results.size() ? ",\n" : "\n");
+    json << "]\n}\n";
+    if (out_path.empty()) {
+        std::cout << json.str();
+    } else {
+        std::ofstream out(out_path);
+        out << json.str();
+        if (!out) {
+            std::cerr << "cannot write " << out_path << '\n';
+            return 2;
+        }
+    }
+    return failures ? 1 : 0;
+}
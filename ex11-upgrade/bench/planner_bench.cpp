@@ -0,0 +1,434 @@
+#include "robokit/planner.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// robokit_bench: Planner::plan over synthetic (open, random-density, maze)
+// and recorded (MovingAI .map) grids, per mode / connectivity / storage, with
+// cold (fresh planner per query) and warm (planner reused) caches. Writes one
+// JSON object per case so runs can be diffed or gated with --baseline.
+//
+//   robokit_bench [--quick] [--map file.map]... [--out results.json]
+//                 [--baseline previous.json] [--tolerance 0.15]
+
+using namespace robokit;
+
+// ---- allocation counting -------------------------------------------------
+
+// The whole replaceable family is replaced, so every new / delete pair stays
+// matched (array, sized, aligned and nothrow forms included) and allocations
+// made through any of them are counted.
+namespace {
+
+std::atomic<std::size_t> g_allocs{0};
+std::atomic<std::size_t> g_alloc_bytes{0};
+constexpr std::size_t kDefaultAlign = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+void* counted_alloc(std::size_t n, std::size_t align) noexcept {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    g_alloc_bytes.fetch_add(n, std::memory_order_relaxed);
+    if (n == 0) n = 1;
+    if (align <= kDefaultAlign) return std::malloc(n);
+#if defined(_MSC_VER)
+    return _aligned_malloc(n, align);
+#else
+    return std::aligned_alloc(align, (n + align - 1) / align * align);
+#endif
+}
+
+void counted_free(void* p, std::size_t align) noexcept {
+#if defined(_MSC_VER)
+    if (align > kDefaultAlign) return _aligned_free(p);
+#else
+    (void)align;
+#endif
+    std::free(p);
+}
+
+void* counted_new(std::size_t n, std::size_t align = kDefaultAlign) {
+    if (void* p = counted_alloc(n, align)) return p;
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(std::size_t n) { return counted_new(n); }
+void* operator new[](std::size_t n) { return counted_new(n); }
+void* operator new(std::size_t n, std::align_val_t a) { return counted_new(n, static_cast<std::size_t>(a)); }
+void* operator new[](std::size_t n, std::align_val_t a) { return counted_new(n, static_cast<std::size_t>(a)); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept { return counted_alloc(n, kDefaultAlign); }
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept { return counted_alloc(n, kDefaultAlign); }
+void* operator new(std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept {
+    return counted_alloc(n, static_cast<std::size_t>(a));
+}
+void* operator new[](std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept {
+    return counted_alloc(n, static_cast<std::size_t>(a));
+}
+
+void operator delete(void* p) noexcept { counted_free(p, kDefaultAlign); }
+void operator delete[](void* p) noexcept { counted_free(p, kDefaultAlign); }
+void operator delete(void* p, std::size_t) noexcept { counted_free(p, kDefaultAlign); }
+void operator delete[](void* p, std::size_t) noexcept { counted_free(p, kDefaultAlign); }
+void operator delete(void* p, std::align_val_t a) noexcept { counted_free(p, static_cast<std::size_t>(a)); }
+void operator delete[](void* p, std::align_val_t a) noexcept { counted_free(p, static_cast<std::size_t>(a)); }
+void operator delete(void* p, std::size_t, std::align_val_t a) noexcept { counted_free(p, static_cast<std::size_t>(a)); }
+void operator delete[](void* p, std::size_t, std::align_val_t a) noexcept { counted_free(p, static_cast<std::size_t>(a)); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { counted_free(p, kDefaultAlign); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { counted_free(p, kDefaultAlign); }
+void operator delete(void* p, std::align_val_t a, const std::nothrow_t&) noexcept {
+    counted_free(p, static_cast<std::size_t>(a));
+}
+void operator delete[](void* p, std::align_val_t a, const std::nothrow_t&) noexcept {
+    counted_free(p, static_cast<std::size_t>(a));
+}
+
+namespace {
+
+// ---- maps ----------------------------------------------------------------
+
+struct BenchMap {
+    std::string name;
+    int w{}, h{};
+    std::vector<uint8_t> cells; // row-major, non-zero = blocked
+};
+
+BenchMap random_map(int w, int h, double density, std::uint32_t seed) {
+    BenchMap m{"random" + std::to_string(static_cast<int>(density * 100)) + "_" + std::to_string(w), w, h, {}};
+    if (density == 0.0) m.name = "open_" + std::to_string(w);
+    m.cells.resize(static_cast<std::size_t>(w) * h);
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution wall(density);
+    for (auto& c : m.cells) c = wall(rng) ? 1 : 0;
+    return m;
+}
+
+// Perfect maze (recursive backtracker) on the odd cells: one-cell corridors,
+// exactly one route between any two free cells.
+BenchMap maze_map(int w, int h, std::uint32_t seed) {
+    BenchMap m{"maze_" + std::to_string(w), w, h, std::vector<uint8_t>(static_cast<std::size_t>(w) * h, 1)};
+    std::mt19937 rng(seed);
+    auto at = [&](int x, int y) -> uint8_t& { return m.cells[static_cast<std::size_t>(y) * w + x]; };
+    std::vector<std::pair<int,int>> stack{{1, 1}};
+    at(1, 1) = 0;
+    static constexpr int kDir[4][2] = {{2,0}, {-2,0}, {0,2}, {0,-2}};
+    while (!stack.empty()) {
+        const auto [x, y] = stack.back();
+        int options[4], n = 0;
+        for (int k = 0; k < 4; ++k) {
+            const int nx = x + kDir[k][0], ny = y + kDir[k][1];
+            if (nx > 0 && nx < w - 1 && ny > 0 && ny < h - 1 && at(nx, ny)) options[n++] = k;
+        }
+        if (n == 0) {
+            stack.pop_back();
+            continue;
+        }
+        const int k = options[rng() % static_cast<unsigned>(n)];
+        at(x + kDir[k][0] / 2, y + kDir[k][1] / 2) = 0;
+        at(x + kDir[k][0], y + kDir[k][1]) = 0;
+        stack.push_back({x + kDir[k][0], y + kDir[k][1]});
+    }
+    return m;
+}
+
+// MovingAI benchmark format: "type/height/width/map" header, then rows where
+// '.', 'G' and 'S' are passable and everything else is blocked.
+bool load_movingai(const std::string& path, BenchMap& m) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string key;
+    m.w = m.h = 0;
+    while (in >> key && key != "map") {
+        if (key == "height") in >> m.h;
+        else if (key == "width") in >> m.w;
+        else in >> key; // "type octile"
+    }
+    if (key != "map" || m.w <= 0 || m.h <= 0) return false;
+    m.cells.assign(static_cast<std::size_t>(m.w) * m.h, 1);
+    std::string row;
+    for (int y = 0; y < m.h && in >> row; ++y) {
+        for (int x = 0; x < m.w && x < static_cast<int>(row.size()); ++x) {
+            const char c = row[x];
+            m.cells[static_cast<std::size_t>(y) * m.w + x] = (c == '.' || c == 'G' || c == 'S') ? 0 : 1;
+        }
+    }
+    const auto slash = path.find_last_of("/\\");
+    m.name = "file_" + path.substr(slash == std::string::npos ? 0 : slash + 1);
+    return true;
+}
+
+// ---- queries -------------------------------------------------------------
+
+struct Query { int sx, sy, gx, gy; };
+
+// Random free starts heading to a handful of shared goals (docking stations),
+// grouped by goal so per-goal caches get a chance to pay off.
+std::vector<Query> make_queries(const BenchMap& m, int count, std::uint32_t seed) {
+    std::vector<int> free;
+    for (int i = 0; i < m.w * m.h; ++i)
+        if (!m.cells[i]) free.push_back(i);
+    std::vector<Query> qs;
+    if (free.empty()) return qs;
+    std::mt19937 rng(seed);
+    auto pick = [&] { return free[rng() % free.size()]; };
+    const int goals[4] = {pick(), pick(), pick(), pick()};
+    for (int i = 0; i < count; ++i) {
+        const int s = pick(), g = goals[i * 4 / count];
+        qs.push_back({s % m.w, s / m.w, g % m.w, g / m.w});
+    }
+    return qs;
+}
+
+// ---- measurement ---------------------------------------------------------
+
+long peak_rss_kb() {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage ru{};
+    getrusage(RUSAGE_SELF, &ru);
+#if defined(__APPLE__)
+    return ru.ru_maxrss / 1024; // bytes on macOS
+#else
+    return ru.ru_maxrss;
+#endif
+#else
+    return -1;
+#endif
+}
+
+struct Config {
+    const char* label;
+    PlannerMode mode;
+    Connectivity conn;
+};
+
+constexpr Config kConfigs[] = {
+    {"astar4", PlannerMode::AStar, Connectivity::Four},
+    {"astar8", PlannerMode::AStar, Connectivity::Eight},
+    {"jps8", PlannerMode::JPS, Connectivity::Eight},
+    {"flow8", PlannerMode::FlowField, Connectivity::Eight},
+};
+
+struct CaseResult {
+    std::string name;
+    int queries{};
+    int solved{};
+    double ns_per_plan{};
+    double expanded_per_plan{};
+    double pushed_per_plan{};
+    double allocs_per_plan{};
+    double alloc_bytes_per_plan{};
+    std::size_t planner_bytes{};
+    long peak_rss_kb{};
+};
+
+// Cold: every query runs on a fresh copy of the loaded planner (no scratch,
+// jump table or flow field yet); the copy itself is not timed or counted.
+// Warm: one untimed pass primes the planner, then the timed passes reuse it.
+CaseResult run_case(const BenchMap& m, const Config& cfg, GridStorage storage, bool cold,
+                    const std::vector<Query>& qs, int repeats) {
+    CaseResult r;
+    r.name = m.name + "/" + cfg.label + "/" + (storage == GridStorage::Packed ? "packed" : "bytes") +
+             "/" + (cold ? "cold" : "warm");
+    r.queries = static_cast<int>(qs.size());
+
+    Planner base(m.w, m.h, {cfg.mode, cfg.conn, GridStorage::Bytes});
+    std::copy(m.cells.begin(), m.cells.end(), base.grid().begin());
+    base.invalidate();
+    base.set_options({cfg.mode, cfg.conn, storage});
+    base.prepare();
+
+    Planner warm = base;
+    if (!cold)
+        for (const auto& q : qs) warm.plan(q.sx, q.sy, q.gx, q.gy);
+
+    using clock = std::chrono::steady_clock;
+    double best_ns = 0;
+    std::chrono::nanoseconds spent{0};
+    // best of `repeats` passes, but slow cases (flow fields on big mazes) stop
+    // once they have used their time budget
+    for (int rep = 0; rep < repeats && spent < std::chrono::seconds(2); ++rep) {
+        std::chrono::nanoseconds total{0};
+        std::size_t expanded = 0, pushed = 0, allocs = 0, bytes = 0;
+        int solved = 0;
+        for (const auto& q : qs) {
+            std::optional<Planner> fresh;
+            if (cold) fresh.emplace(base);
+            Planner& p = cold ? *fresh : warm;
+            const std::size_t a0 = g_allocs.load(std::memory_order_relaxed);
+            const std::size_t b0 = g_alloc_bytes.load(std::memory_order_relaxed);
+            const auto t0 = clock::now();
+            const auto path = p.plan(q.sx, q.sy, q.gx, q.gy);
+            total += clock::now() - t0;
+            allocs += g_allocs.load(std::memory_order_relaxed) - a0;
+            bytes += g_alloc_bytes.load(std::memory_order_relaxed) - b0;
+            expanded += p.last_stats().expanded;
+            pushed += p.last_stats().pushed;
+            solved += !path.empty();
+        }
+        spent += total;
+        const double ns = static_cast<double>(total.count()) / std::max<std::size_t>(qs.size(), 1);
+        if (rep == 0 || ns < best_ns) best_ns = ns;
+        if (rep == 0) {
+            const double n = static_cast<double>(std::max<std::size_t>(qs.size(), 1));
+            r.solved = solved;
+            r.expanded_per_plan = static_cast<double>(expanded) / n;
+            r.pushed_per_plan = static_cast<double>(pushed) / n;
+            r.allocs_per_plan = static_cast<double>(allocs) / n;
+            r.alloc_bytes_per_plan = static_cast<double>(bytes) / n;
+        }
+    }
+    r.ns_per_plan = best_ns;
+    r.planner_bytes = (cold ? base : warm).memory_bytes();
+    r.peak_rss_kb = peak_rss_kb();
+    return r;
+}
+
+// ---- JSON ----------------------------------------------------------------
+
+std::string to_json(const CaseResult& r) {
+    char buf[512];
+    std::snprintf(buf, sizeof buf,
+                  "{\"name\": \"%s\", \"queries\": %d, \"solved\": %d, \"ns_per_plan\": %.1f, "
+                  "\"expanded_per_plan\": %.1f, \"pushed_per_plan\": %.1f, \"allocs_per_plan\": %.2f, "
+                  "\"alloc_bytes_per_plan\": %.1f, \"planner_bytes\": %zu, \"peak_rss_kb\": %ld}",
+                  r.name.c_str(), r.queries, r.solved, r.ns_per_plan, r.expanded_per_plan, r.pushed_per_plan,
+                  r.allocs_per_plan, r.alloc_bytes_per_plan, r.planner_bytes, r.peak_rss_kb);
+    return buf;
+}
+
+// Baseline files are our own output: one case object per line, so a key
+// lookup within the line is all the parsing needed.
+bool json_field(const std::string& line, const std::string& key, std::string& out) {
+    const auto k = line.find("\"" + key + "\": ");
+    if (k == std::string::npos) return false;
+    auto v = k + key.size() + 4;
+    if (line[v] == '"') {
+        const auto end = line.find('"', v + 1);
+        out = line.substr(v + 1, end - v - 1);
+    } else {
+        const auto end = line.find_first_of(",}", v);
+        out = line.substr(v, end - v);
+    }
+    return true;
+}
+
+// Timing is compared with the tolerance; expansions and allocations are
+// deterministic, so any growth beyond it (plus one, for tiny counts) is flagged.
+int compare_baseline(const std::string& path, const std::vector<CaseResult>& results, double tolerance) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "cannot read baseline " << path << '\n';
+        return 2;
+    }
+    std::map<std::string, std::string> base;
+    std::string line, name;
+    while (std::getline(in, line))
+        if (json_field(line, "name", name)) base[name] = line;
+
+    int regressions = 0;
+    auto check = [&](const CaseResult& r, const char* key, double now, double slack) {
+        std::string old;
+        if (!json_field(base[r.name], key, old)) return;
+        const double was = std::strtod(old.c_str(), nullptr);
+        if (now > was * (1.0 + tolerance) + slack) {
+            std::cerr << "REGRESSION " << r.name << ' ' << key << ": " << was << " -> " << now << '\n';
+            ++regressions;
+        }
+    };
+    for (const auto& r : results) {
+        if (!base.count(r.name)) continue;
+        check(r, "ns_per_plan", r.ns_per_plan, 0.0);
+        check(r, "expanded_per_plan", r.expanded_per_plan, 1.0);
+        check(r, "allocs_per_plan", r.allocs_per_plan, 1.0);
+    }
+    std::cerr << regressions << " regression(s) against " << path << '\n';
+    return regressions ? 1 : 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool quick = false;
+    std::string out_path, baseline;
+    double tolerance = 0.15;
+    std::vector<std::string> map_files;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--quick") quick = true;
+        else if (a == "--out" && i + 1 < argc) out_path = argv[++i];
+        else if (a == "--map" && i + 1 < argc) map_files.push_back(argv[++i]);
+        else if (a == "--baseline" && i + 1 < argc) baseline = argv[++i];
+        else if (a == "--tolerance" && i + 1 < argc) tolerance = std::strtod(argv[++i], nullptr);
+        else {
+            std::cerr << "usage: " << argv[0]
+                      << " [--quick] [--map file.map]... [--out results.json] [--baseline old.json] [--tolerance 0.15]\n";
+            return 2;
+        }
+    }
+
+    // smallest maps first so peak_rss_kb grows with the cases that need it
+    std::vector<BenchMap> maps;
+    const std::vector<int> sizes = quick ? std::vector<int>{32, 64} : std::vector<int>{64, 256, 1024};
+    for (int s : sizes) {
+        maps.push_back(random_map(s, s, 0.0, 1));
+        maps.push_back(random_map(s, s, 0.10, 2));
+        maps.push_back(random_map(s, s, 0.25, 3));
+        maps.push_back(maze_map(s, s, 4));
+    }
+    for (const auto& f : map_files) {
+        BenchMap m;
+        if (!load_movingai(f, m)) {
+            std::cerr << "cannot load map " << f << '\n';
+            return 2;
+        }
+        maps.push_back(std::move(m));
+    }
+
+    std::vector<CaseResult> results;
+    for (const auto& m : maps) {
+        // keep per-case work roughly flat as maps grow
+        const int area = m.w * m.h;
+        const int count = quick ? 16 : std::clamp(4'000'000 / std::max(area, 1), 8, 256);
+        const auto qs = make_queries(m, count, 7);
+        for (const auto& cfg : kConfigs) {
+            for (auto storage : {GridStorage::Bytes, GridStorage::Packed}) {
+                for (bool cold : {true, false}) {
+                    results.push_back(run_case(m, cfg, storage, cold, qs, quick ? 1 : 3));
+                    std::cerr << to_json(results.back()) << '\n';
+                }
+            }
+        }
+    }
+
+    std::ostringstream json;
+    json << "{\n\"robokit_version\": \"" << ROBOKIT_VERSION << "\",\n\"quick\": " << (quick ? "true" : "false")
+         << ",\n\"cases\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i)
+        json << to_json(results[i]) << (i + 1 < results.size() ? ",\n" : "\n");
+    json << "]\n}\n";
+    if (out_path.empty()) {
+        std::cout << json.str();
+    } else {
+        std::ofstream out(out_path);
+        out << json.str();
+        if (!out) {
+            std::cerr << "cannot write " << out_path << '\n';
+            return 2;
+        }
+    }
+
+    return baseline.empty() ? 0 : compare_baseline(baseline, results, tolerance);
+}
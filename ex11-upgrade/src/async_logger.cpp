@@ -0,0 +1,118 @@
+#include "robokit/async_logger.hpp"
+#include <algorithm>
+#include <span>
+
+namespace robokit::log {
+
+namespace {
+
+std::atomic<std::uint64_t> g_next_logger_id{1};
+
+// This thread's ring in the logger with id `logger` (0 = none yet).
+struct ThreadRing {
+    std::uint64_t logger{0};
+    detail::RecordRing* ring{nullptr};
+};
+thread_local ThreadRing t_ring;
+
+} // namespace
+
+AsyncLogger::AsyncLogger(AsyncLoggerOptions opts)
+    : opts_(opts), id_(g_next_logger_id.fetch_add(1, std::memory_order_relaxed)) {
+    opts_.batch_records = std::max<std::size_t>(opts_.batch_records, 1);
+    if (!opts_.sink) opts_.sink = print_batch_sink;
+    thread_ = std::jthread([this](std::stop_token st) { run(st); });
+    set_sink(&AsyncLogger::enqueue, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+    set_sink(nullptr);
+    thread_.request_stop(); // wakes the backend, which drains once more and exits
+    thread_.join();
+}
+
+void AsyncLogger::enqueue(const Record& r, void* context) {
+    auto* self = static_cast<AsyncLogger*>(context);
+    if (t_ring.logger != self->id_) t_ring = {self->id_, self->add_ring()};
+    t_ring.ring->push(r);
+}
+
+detail::RecordRing* AsyncLogger::add_ring() {
+    std::lock_guard lk(rings_mtx_);
+    rings_.push_back(std::make_unique<detail::RecordRing>(opts_.ring_records));
+    return rings_.back().get();
+}
+
+void AsyncLogger::flush() {
+    std::unique_lock lk(wait_mtx_);
+    const std::uint64_t ticket = flush_requested_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    wake_cv_.notify_one();
+    done_cv_.wait(lk, [&] { return flush_done_ >= ticket; });
+}
+
+std::uint64_t AsyncLogger::dropped() const {
+    std::lock_guard lk(rings_mtx_);
+    std::uint64_t n = 0;
+    for (const auto& r : rings_) n += r->dropped();
+    return n;
+}
+
+std::size_t AsyncLogger::threads() const {
+    std::lock_guard lk(rings_mtx_);
+    return rings_.size();
+}
+
+void AsyncLogger::run(std::stop_token st) {
+    std::vector<Record> batch;
+    batch.reserve(opts_.batch_records);
+    std::vector<detail::RecordRing*> rings;
+    for (;;) {
+        // read both before draining: whatever was logged before a flush()
+        // or the stop request is then visible to this pass
+        const std::uint64_t ticket = flush_requested_.load(std::memory_order_acquire);
+        const bool stopping = st.stop_requested();
+        {
+            std::lock_guard lk(rings_mtx_);
+            rings.clear();
+            for (const auto& r : rings_) rings.push_back(r.get());
+        }
+        const std::size_t drained = drain(rings, batch);
+
+        std::unique_lock lk(wait_mtx_);
+        if (ticket > flush_done_) {
+            flush_done_ = ticket;
+            done_cv_.notify_all();
+        }
+        if (stopping) return;
+        if (drained == 0)
+            wake_cv_.wait_for(lk, st, opts_.idle_poll,
+                              [&] { return flush_requested_.load(std::memory_order_relaxed) != ticket; });
+    }
+}
+
+std::size_t AsyncLogger::drain(std::vector<detail::RecordRing*>& rings, std::vector<Record>& batch) {
+    // at most one ring's worth from each: everything queued when the pass
+    // started, without chasing a thread that keeps logging
+    std::size_t total = 0;
+    for (auto* ring : rings) {
+        for (std::size_t left = ring->capacity(); left > 0;) {
+            const std::size_t n = ring->pop(batch, std::min(left, opts_.batch_records - batch.size()));
+            if (n == 0) break;
+            left -= n;
+            total += n;
+            if (batch.size() == opts_.batch_records) deliver(batch);
+        }
+    }
+    if (!batch.empty()) deliver(batch);
+    return total;
+}
+
+void AsyncLogger::deliver(std::vector<Record>& batch) {
+    // rings are drained one after another; put the threads back in time order
+    std::stable_sort(batch.begin(), batch.end(), [](const Record& a, const Record& b) { return a.stamp < b.stamp; });
+    opts_.sink(std::span<const Record>(batch), opts_.context);
+    delivered_.fetch_add(batch.size(), std::memory_order_relaxed);
+    batch.clear();
+}
+
+} // namespace robokit::log
@@ -0,0 +1,103 @@
+#include "robokit/batch_planner.hpp"
+#include <algorithm>
+
+namespace robokit {
+
+BatchPlanner::BatchPlanner(Planner& planner, BatchOptions opts)
+    : planner_(planner), opts_(opts), pool_(opts.threads), workers_(pool_.size()) {}
+
+void BatchPlanner::plan(std::span<const PlanQuery> queries, BatchResult& out) {
+    planner_.prepare();
+    stats_ = {};
+    const auto n = queries.size();
+    out.width = planner_.width();
+    out.cells.clear();
+    out.spans.assign(n, PathSpan{});
+    if (n == 0) return;
+
+    // Group by goal; a stable sort keeps each group's queries in input order.
+    order_.resize(n);
+    for (std::uint32_t i = 0; i < n; ++i) order_[i] = i;
+    auto goal = [&](std::uint32_t q) { return cell_of(queries[q].gx, queries[q].gy); };
+    std::stable_sort(order_.begin(), order_.end(), [&](auto a, auto b) { return goal(a) < goal(b); });
+    jobs_.clear();
+    for (std::uint32_t i = 0; i < n;) {
+        std::uint32_t j = i + 1;
+        while (j < n && goal(order_[j]) == goal(order_[i])) ++j;
+        const std::uint32_t len = j - i;
+        if (len >= std::max<std::size_t>(2, opts_.share_goal) && goal(order_[i]) >= 0) {
+            jobs_.push_back({i, len, true});
+        } else {
+            for (std::uint32_t k = i; k < j; ++k) jobs_.push_back({k, 1, false});
+        }
+        i = j;
+    }
+
+    for (auto& w : workers_) {
+        w.cells.clear();
+        w.totals = {};
+    }
+    placed_.assign(n, Placement{0, 0, 0, -1});
+    // Shared fields are the big items; grain 1 lets idle workers pick them up.
+    pool_.parallel_for(jobs_.size(), 1, [&](std::size_t begin, std::size_t end, std::size_t wi) {
+        for (std::size_t j = begin; j < end; ++j)
+            run_job(jobs_[j], queries, workers_[wi], static_cast<std::uint32_t>(wi));
+    });
+
+    std::vector<std::uint32_t> base(workers_.size(), 0);
+    std::size_t total = 0;
+    for (std::size_t w = 0; w < workers_.size(); ++w) {
+        base[w] = static_cast<std::uint32_t>(total);
+        total += workers_[w].cells.size();
+        stats_.searches += workers_[w].totals.searches;
+        stats_.shared_fields += workers_[w].totals.shared_fields;
+        stats_.expanded += workers_[w].totals.expanded;
+    }
+    out.cells.reserve(total);
+    for (const auto& w : workers_) out.cells.insert(out.cells.end(), w.cells.begin(), w.cells.end());
+    for (std::size_t q = 0; q < n; ++q) {
+        const auto& p = placed_[q];
+        if (p.length > 0) out.spans[q] = {base[p.worker] + p.offset, p.length, p.cost};
+    }
+}
+
+void BatchPlanner::run_job(const Job& job, std::span<const PlanQuery> queries, Worker& w, std::uint32_t wi) {
+    auto place = [&](std::uint32_t q, std::size_t offset, int cost) {
+        const auto length = static_cast<std::uint32_t>(w.cells.size() - offset);
+        if (length > 0) placed_[q] = {wi, static_cast<std::uint32_t>(offset), length, cost};
+    };
+
+    if (!job.shared) {
+        const std::uint32_t q = order_[job.first];
+        const auto& pq = queries[q];
+        const auto offset = w.cells.size();
+        planner_.plan_into(pq.sx, pq.sy, pq.gx, pq.gy, w.scratch, w.stats, w.cells);
+        ++w.totals.searches;
+        w.totals.expanded += w.stats.expanded;
+        place(q, offset, w.stats.cost);
+        return;
+    }
+
+    const auto ids = std::span<const std::uint32_t>(order_).subspan(job.first, job.count);
+    w.targets.clear();
+    for (std::uint32_t q : ids) {
+        if (planner_.free_cell(queries[q].sx, queries[q].sy)) w.targets.push_back(cell_of(queries[q].sx, queries[q].sy));
+    }
+    std::sort(w.targets.begin(), w.targets.end());
+    w.targets.erase(std::unique(w.targets.begin(), w.targets.end()), w.targets.end());
+    const int g = cell_of(queries[ids[0]].gx, queries[ids[0]].gy);
+    planner_.settle_from(g, w.targets, w.scratch, w.stats);
+    ++w.totals.shared_fields;
+    w.totals.expanded += w.stats.expanded;
+    if (w.stats.expanded == 0) return; // goal blocked
+
+    // The field's parent links run start -> goal, already in path order.
+    for (std::uint32_t q : ids) {
+        const int start = cell_of(queries[q].sx, queries[q].sy);
+        if (start < 0 || !planner_.free_cell(queries[q].sx, queries[q].sy)) continue;
+        const auto offset = w.cells.size();
+        if (planner_.trace_settled(w.scratch, start, w.cells)) place(q, offset, w.scratch.g[start]);
+    }
+}
+
+} // namespace robokit
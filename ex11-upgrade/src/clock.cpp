@@ -0,0 +1,13 @@
+#include "robokit/clock.hpp"
+#include "robokit/scheduler.hpp"
+
+namespace robokit {
+
+Clock& Clock::steady() {
+    static SteadyClock clock;
+    return clock;
+}
+
+void SteadyClock::sleep_until(Timestamp tp) { sleep_until_abs(tp); }
+
+} // namespace robokit
@@ -1,2 +1,144 @@
 #include "robokit/config.hpp"
-// Implementation is header-only for now (intentional for later refactor)
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ROBOKIT_HAS_MMAP 1
+#endif
+
+namespace robokit {
+
+namespace {
+
+std::string_view trim(std::string_view s) {
+    constexpr std::string_view ws = " \t\r\v\f";
+    const auto b = s.find_first_not_of(ws);
+    if (b == std::string_view::npos) return {};
+    return s.substr(b, s.find_last_not_of(ws) - b + 1);
+}
+
+// The whole of `s` as a number, in the forms std::stod took: an optional
+// sign, then decimal or 0x-prefixed hex digits (inf / nan included).
+bool parse_number(std::string_view s, double& out) {
+    const char* p = s.data();
+    const char* end = p + s.size();
+    bool negative = false;
+    if (p != end && (*p == '+' || *p == '-')) negative = *p++ == '-';
+    auto fmt = std::chars_format::general;
+    if (end - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+        p += 2;
+        fmt = std::chars_format::hex;
+    }
+    if (p == end || *p == '+' || *p == '-') return false; // one sign, before any 0x
+    const auto [ptr, ec] = std::from_chars(p, end, out, fmt);
+    if (ec != std::errc{} || ptr != end) return false;
+    if (negative) out = -out;
+    return true;
+}
+
+} // namespace
+
+bool Config::load_file(const std::string& path) {
+    unmap();
+    error_line_ = 0;
+#if defined(ROBOKIT_HAS_MMAP)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    const std::size_t size = static_cast<std::size_t>(st.st_size);
+    if (size > 0) {
+        void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+#if defined(MADV_SEQUENTIAL)
+        ::madvise(p, size, MADV_SEQUENTIAL);
+#endif
+        map_ = static_cast<const char*>(p);
+        mapped_ = size;
+    }
+    ::close(fd); // the mapping stays valid
+    return parse({map_, mapped_});
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    owned_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return parse({owned_.data(), owned_.size()});
+#endif
+}
+
+bool Config::load_string(std::string_view text) {
+    std::vector<char> copy(text.begin(), text.end()); // `text` may view our own contents
+    unmap();
+    owned_ = std::move(copy);
+    return parse({owned_.data(), owned_.size()});
+}
+
+void Config::unmap() {
+    entries_.clear();
+    slots_.clear();
+#if defined(ROBOKIT_HAS_MMAP)
+    if (map_) ::munmap(const_cast<char*>(map_), mapped_);
+#endif
+    map_ = nullptr;
+    mapped_ = 0;
+    owned_.clear();
+}
+
+bool Config::parse(std::string_view text) {
+    error_line_ = 0;
+    // at most one entry per line; the index stays at most half full
+    const std::size_t lines = static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n')) + 1;
+    entries_.reserve(lines);
+    slots_.assign(std::bit_ceil(2 * lines), kEmpty);
+    std::size_t line_no = 0;
+    while (!text.empty()) {
+        ++line_no;
+        const char* nl = static_cast<const char*>(std::memchr(text.data(), '\n', text.size()));
+        const std::size_t len = nl ? static_cast<std::size_t>(nl - text.data()) : text.size();
+        const std::string_view line = trim(text.substr(0, len));
+        text.remove_prefix(nl ? len + 1 : len);
+        if (line.empty() || line.front() == '#') continue;
+
+        const auto eq = line.find('=');
+        const std::string_view key = eq == std::string_view::npos ? std::string_view{} : trim(line.substr(0, eq));
+        if (key.empty()) {
+            if (error_line_ == 0) error_line_ = line_no;
+            continue;
+        }
+        Entry e;
+        e.key = key;
+        e.text = trim(line.substr(eq + 1));
+        e.is_number = parse_number(e.text, e.number);
+        insert(e);
+    }
+    return error_line_ == 0;
+}
+
+void Config::insert(const Entry& e) {
+    const std::size_t mask = slots_.size() - 1;
+    std::size_t h = std::hash<std::string_view>{}(e.key) & mask;
+    for (; slots_[h] != kEmpty; h = (h + 1) & mask) {
+        if (entries_[slots_[h]].key == e.key) {
+            entries_[slots_[h]] = e; // last one wins
+            return;
+        }
+    }
+    slots_[h] = static_cast<std::uint32_t>(entries_.size());
+    entries_.push_back(e);
+}
+
+} // namespace robokit
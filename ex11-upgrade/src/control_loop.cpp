@@ -1,5 +1,7 @@
 #include "robokit/control_loop.hpp"
 #include "robokit/logging.hpp"
+#include "robokit/telemetry.hpp"
+#include <algorithm>
 #include <chrono>
 
 namespace robokit {
@@ -7,25 +9,68 @@ namespace robokit {
 void ControlLoop::start() {
     if (running_) return;
     running_ = true;
-    thread_ = std::thread([this]() {
-        log::info("Control loop started");
-        auto next = std::chrono::steady_clock::now();
-        while (running_) {
-            // busy wait for ~10ms period (inefficient)
-            next += std::chrono::milliseconds(10);
-            while (std::chrono::steady_clock::now() < next) { /* spin */ }
-            // naive joint update
-            for (auto& j : robot_.joints()) {
-                j.position += 0.01; // arbitrary
-            }
-        }
-        log::info("Control loop stopped");
+    scheduler_.reset();
+    tasks_.start();
+    thread_ = std::jthread([this](std::stop_token st) {
+        ROBOKIT_LOG_INFO("Control loop started");
+        while (scheduler_.wait_next(st)) tick();
+        ROBOKIT_LOG_INFO("Control loop stopped");
     });
 }
 
+void ControlLoop::tick() {
+    // naive joint update, kept inside the limits; contiguous fields, so this
+    // compiles to packed add / max / min
+    JointStore& js = robot_.joints();
+    const std::span<double> q = js.positions();
+    const std::span<const double> lo = js.lower_limits(), hi = js.upper_limits();
+    for (std::size_t j = 0; j < q.size(); ++j) {
+        q[j] = std::min(std::max(q[j] + 0.01, lo[j]), hi[j]); // +0.01 is arbitrary
+    }
+    robot_.publish_state();
+}
+
+std::uint64_t ControlLoop::simulate(std::chrono::steady_clock::duration span) {
+    auto* clock = dynamic_cast<VirtualClock*>(&robot_.clock());
+    if (!clock || running_) return 0;
+    const auto start = clock->now(), end = start + span;
+    tasks_.sim_reset(start);
+    std::uint64_t ticks = 0;
+    for (auto next = start + scheduler_.period(); next <= end; next += scheduler_.period()) {
+        tasks_.sim_run_until(*clock, next);
+        clock->advance_to(next);
+        tick();
+        ++ticks;
+    }
+    tasks_.sim_run_until(*clock, end + std::chrono::nanoseconds(1));
+    clock->advance_to(end);
+    return ticks;
+}
+
+std::uint64_t ControlLoop::replay(const TelemetryReader& log, const std::function<void(std::uint64_t)>& after_tick) {
+    auto* clock = dynamic_cast<VirtualClock*>(&robot_.clock());
+    if (!clock || running_ || !log.is_open() || log.frames() == 0 || log.dof() != robot_.joints().size()) return 0;
+    clock->advance_to(log.origin());
+    tasks_.sim_reset(clock->now());
+    for (std::uint64_t f = 0; f < log.frames(); ++f) {
+        const Timestamp stamp = log.stamp(f);
+        tasks_.sim_run_until(*clock, stamp);
+        clock->advance_to(stamp);
+        log.read_joints(f, robot_.joints());
+        tick();
+        if (after_tick) after_tick(f);
+    }
+    tasks_.sim_run_until(*clock, clock->now() + std::chrono::nanoseconds(1));
+    return log.frames();
+}
+
 void ControlLoop::stop() {
+    tasks_.stop();
+    if (thread_.joinable()) {
+        thread_.request_stop();
+        thread_.join();
+    }
     running_ = false;
-    if (thread_.joinable()) thread_.join();
 }
 
 } // namespace robokit
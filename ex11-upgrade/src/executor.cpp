@@ -0,0 +1,161 @@
+#include "robokit/executor.hpp"
+#include "robokit/logging.hpp"
+#include <algorithm>
+#include <atomic>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace robokit {
+
+namespace {
+
+// Best-effort pinning; returns the cpu actually bound or -1.
+int pin_current_thread(int cpu) {
+#if defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return -1;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0 ? cpu : -1;
+#else
+    (void)cpu;
+    return -1;
+#endif
+}
+
+// SCHED_FIFO needs CAP_SYS_NICE / rtprio limits; EPERM leaves the thread on SCHED_OTHER.
+bool make_current_thread_fifo(int priority) {
+#if defined(__linux__)
+    sched_param sp{};
+    sp.sched_priority = std::clamp(priority, sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO));
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp) == 0;
+#else
+    (void)priority;
+    return false;
+#endif
+}
+
+} // namespace
+
+RateMonotonicExecutor::RateMonotonicExecutor(ExecutorOptions opts) : opts_(std::move(opts)) {
+    if (opts_.workers == 0) opts_.workers = 1;
+}
+
+RateMonotonicExecutor::~RateMonotonicExecutor() { stop(); }
+
+std::size_t RateMonotonicExecutor::add_task(std::string name, clock::duration period, std::function<void()> fn) {
+    if (running() || period <= clock::duration::zero() || !fn) return npos;
+    auto t = std::make_unique<Task>();
+    t->name = std::move(name);
+    t->period = period;
+    t->fn = std::move(fn);
+    tasks_.push_back(std::move(t));
+    return tasks_.size() - 1;
+}
+
+void RateMonotonicExecutor::start() {
+    if (running() || tasks_.empty()) return;
+    // Rate-monotonic order: shortest period = highest priority. Ids stay stable;
+    // workers walk order_ instead.
+    order_.clear();
+    for (auto& t : tasks_) order_.push_back(t.get());
+    std::stable_sort(order_.begin(), order_.end(),
+                     [](const Task* a, const Task* b) { return a->period < b->period; });
+
+    const std::size_t n_workers = std::min(opts_.workers, tasks_.size());
+    info_.assign(n_workers, {});
+    for (std::size_t w = 0; w < n_workers; ++w) {
+        info_[w].first_task = w * tasks_.size() / n_workers;
+        info_[w].task_count = (w + 1) * tasks_.size() / n_workers - info_[w].first_task;
+    }
+
+    const auto t0 = clock::now();
+    for (auto& t : tasks_) {
+        t->next = t0 + t->period;
+        t->stats.reset();
+    }
+
+    // Workers report their pin/priority outcome before start() returns.
+    std::atomic<std::size_t> ready{0};
+    workers_.reserve(n_workers);
+    for (std::size_t w = 0; w < n_workers; ++w) {
+        workers_.emplace_back([this, w, &ready](std::stop_token st) {
+            auto& info = info_[w];
+            if (!opts_.cpus.empty()) info.cpu = pin_current_thread(opts_.cpus[w % opts_.cpus.size()]);
+            if (opts_.realtime) {
+                info.realtime = make_current_thread_fifo(opts_.rt_priority + static_cast<int>(info_.size() - 1 - w));
+            }
+            ready.fetch_add(1, std::memory_order_release);
+            ready.notify_one();
+            run_worker(st, w);
+        });
+    }
+    for (std::size_t r = ready.load(std::memory_order_acquire); r < n_workers; r = ready.load(std::memory_order_acquire)) {
+        ready.wait(r, std::memory_order_acquire);
+    }
+    if (opts_.realtime && std::none_of(info_.begin(), info_.end(), [](const WorkerInfo& i) { return i.realtime; })) {
+        ROBOKIT_LOG_WARN("SCHED_FIFO not permitted; executor workers run with default scheduling");
+    }
+}
+
+void RateMonotonicExecutor::stop() {
+    for (auto& w : workers_) w.request_stop();
+    workers_.clear(); // jthread joins
+}
+
+void RateMonotonicExecutor::sim_reset(clock::time_point start) {
+    for (auto& t : tasks_) {
+        t->next = start + t->period;
+        t->stats.reset();
+    }
+}
+
+std::uint64_t RateMonotonicExecutor::sim_run_until(VirtualClock& clock, clock::time_point end) {
+    if (running()) return 0;
+    std::uint64_t runs = 0;
+    for (;;) {
+        Task* due = nullptr;
+        for (auto& t : tasks_) {
+            if (t->next < end && (!due || t->next < due->next || (t->next == due->next && t->period < due->period)))
+                due = t.get();
+        }
+        if (!due) return runs;
+        clock.advance_to(due->next);
+        due->stats.record(clock.now() - due->next);
+        due->fn();
+        due->next += due->period;
+        ++runs;
+    }
+}
+
+void RateMonotonicExecutor::run_worker(std::stop_token st, std::size_t w) {
+    const auto first = order_.begin() + static_cast<std::ptrdiff_t>(info_[w].first_task);
+    const auto last = first + static_cast<std::ptrdiff_t>(info_[w].task_count);
+    while (!st.stop_requested()) {
+        auto wake = (*first)->next;
+        for (auto it = first; it != last; ++it) wake = std::min(wake, (*it)->next);
+        {
+            std::unique_lock lk(mtx_);
+            if (cv_.wait_until(lk, st, wake, [] { return false; }) || st.stop_requested()) break;
+        }
+        for (auto it = first; it != last; ++it) {
+            Task& t = **it;
+            auto now = clock::now();
+            if (now < t.next) continue;
+            t.stats.record(now - t.next);
+            t.fn();
+            t.next += t.period;
+            const auto done = clock::now();
+            if (done > t.next) {
+                // Deadline miss: finished after the next release; drop the releases we lost.
+                const auto missed = static_cast<std::uint64_t>((done - t.next) / t.period) + 1;
+                t.next += t.period * static_cast<clock::rep>(missed);
+                t.stats.record_overrun(missed);
+            }
+        }
+    }
+}
+
+} // namespace robokit
@@ -0,0 +1,235 @@
+#include "robokit/gemm.hpp"
+#include <algorithm>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define ROBOKIT_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// Goto-style blocking: C is updated in kNC-wide column blocks and kKC-deep
+// slices of the shared dimension. The B slice (kKC x kNC, ~4 MB at most)
+// is packed into kNR-wide column strips, each row panel of A (kMC x kKC,
+// fits L2) into kMR-tall row strips, and a kMR x kNR micro-kernel keeps its
+// C tile in registers for the whole slice. Packing zero-pads the edges so
+// the micro-kernel always runs full tiles. The AVX2/FMA micro-kernel
+// and point-cloud kernels are chosen at runtime, as in kinematics_batch.cpp.
+
+namespace robokit::linalg {
+
+namespace {
+
+constexpr std::size_t kMR = 4;
+constexpr std::size_t kNR = 8;
+constexpr std::size_t kMC = 96;   // multiple of kMR
+constexpr std::size_t kKC = 256;
+constexpr std::size_t kNC = 2048; // multiple of kNR
+
+std::size_t round_up(std::size_t n, std::size_t m) { return (n + m - 1) / m * m; }
+
+// c[i*ldc + j] += sum_p a[p*kMR + i] * b[p*kNR + j] for one kMR x kNR tile.
+using MicroKernel = void (*)(std::size_t kc, const double* a, const double* b, double* c, std::size_t ldc);
+
+void micro_scalar(std::size_t kc, const double* a, const double* b, double* c, std::size_t ldc) {
+    double acc[kMR][kNR] = {};
+    for (std::size_t p = 0; p < kc; ++p) {
+        const double* bp = b + p * kNR;
+        for (std::size_t i = 0; i < kMR; ++i) {
+            const double ai = a[p * kMR + i];
+            for (std::size_t j = 0; j < kNR; ++j) acc[i][j] += ai * bp[j];
+        }
+    }
+    for (std::size_t i = 0; i < kMR; ++i)
+        for (std::size_t j = 0; j < kNR; ++j) c[i * ldc + j] += acc[i][j];
+}
+
+#ifdef ROBOKIT_X86_SIMD
+__attribute__((target("avx2,fma")))
+void micro_avx2(std::size_t kc, const double* a, const double* b, double* c, std::size_t ldc) {
+    __m256d c00 = _mm256_setzero_pd(), c01 = c00, c10 = c00, c11 = c00;
+    __m256d c20 = c00, c21 = c00, c30 = c00, c31 = c00;
+    for (std::size_t p = 0; p < kc; ++p) {
+        const __m256d b0 = _mm256_loadu_pd(b + p * kNR);
+        const __m256d b1 = _mm256_loadu_pd(b + p * kNR + 4);
+        const double* ap = a + p * kMR;
+        __m256d ai = _mm256_broadcast_sd(ap);
+        c00 = _mm256_fmadd_pd(ai, b0, c00);
+        c01 = _mm256_fmadd_pd(ai, b1, c01);
+        ai = _mm256_broadcast_sd(ap + 1);
+        c10 = _mm256_fmadd_pd(ai, b0, c10);
+        c11 = _mm256_fmadd_pd(ai, b1, c11);
+        ai = _mm256_broadcast_sd(ap + 2);
+        c20 = _mm256_fmadd_pd(ai, b0, c20);
+        c21 = _mm256_fmadd_pd(ai, b1, c21);
+        ai = _mm256_broadcast_sd(ap + 3);
+        c30 = _mm256_fmadd_pd(ai, b0, c30);
+        c31 = _mm256_fmadd_pd(ai, b1, c31);
+    }
+    const __m256d acc[kMR][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}};
+    for (std::size_t i = 0; i < kMR; ++i) {
+        double* row = c + i * ldc;
+        _mm256_storeu_pd(row, _mm256_add_pd(_mm256_loadu_pd(row), acc[i][0]));
+        _mm256_storeu_pd(row + 4, _mm256_add_pd(_mm256_loadu_pd(row + 4), acc[i][1]));
+    }
+}
+#endif
+
+MicroKernel pick_micro_kernel() {
+#ifdef ROBOKIT_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return micro_avx2;
+#endif
+    return micro_scalar;
+}
+
+// out_i = R p_i + t for rows [begin, end). Generic and AVX2 versions; the
+// AVX2 one computes a point per ymm (fourth lane unused) and writes three
+// lanes through a mask so in-place transforms never clobber the next point.
+using CloudKernel = void (*)(const Mat4d& pose, MatView<const double> points, MatView<double> out,
+                             std::size_t begin, std::size_t end);
+
+void cloud_scalar(const Mat4d& pose, MatView<const double> points, MatView<double> out,
+                  std::size_t begin, std::size_t end) {
+    const double r00 = pose(0, 0), r01 = pose(0, 1), r02 = pose(0, 2), tx = pose(0, 3);
+    const double r10 = pose(1, 0), r11 = pose(1, 1), r12 = pose(1, 2), ty = pose(1, 3);
+    const double r20 = pose(2, 0), r21 = pose(2, 1), r22 = pose(2, 2), tz = pose(2, 3);
+    for (std::size_t i = begin; i < end; ++i) {
+        const double* p = points.data + i * points.stride;
+        const double x = p[0], y = p[1], z = p[2];
+        double* o = out.data + i * out.stride;
+        o[0] = r00 * x + r01 * y + r02 * z + tx;
+        o[1] = r10 * x + r11 * y + r12 * z + ty;
+        o[2] = r20 * x + r21 * y + r22 * z + tz;
+    }
+}
+
+#ifdef ROBOKIT_X86_SIMD
+__attribute__((target("avx2,fma")))
+void cloud_avx2(const Mat4d& pose, MatView<const double> points, MatView<double> out,
+                std::size_t begin, std::size_t end) {
+    const __m256d c0 = _mm256_setr_pd(pose(0, 0), pose(1, 0), pose(2, 0), 0.0);
+    const __m256d c1 = _mm256_setr_pd(pose(0, 1), pose(1, 1), pose(2, 1), 0.0);
+    const __m256d c2 = _mm256_setr_pd(pose(0, 2), pose(1, 2), pose(2, 2), 0.0);
+    const __m256d t = _mm256_setr_pd(pose(0, 3), pose(1, 3), pose(2, 3), 0.0);
+    const __m256i xyz = _mm256_setr_epi64x(-1, -1, -1, 0);
+    for (std::size_t i = begin; i < end; ++i) {
+        const double* p = points.data + i * points.stride;
+        __m256d o = _mm256_fmadd_pd(c0, _mm256_broadcast_sd(p), t);
+        o = _mm256_fmadd_pd(c1, _mm256_broadcast_sd(p + 1), o);
+        o = _mm256_fmadd_pd(c2, _mm256_broadcast_sd(p + 2), o);
+        _mm256_maskstore_pd(out.data + i * out.stride, xyz, o);
+    }
+}
+#endif
+
+CloudKernel pick_cloud_kernel() {
+#ifdef ROBOKIT_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return cloud_avx2;
+#endif
+    return cloud_scalar;
+}
+
+// A rows [i0, i0+mc) x cols [p0, p0+kc), times alpha, as kMR-row strips.
+void pack_a(MatView<const double> a, std::size_t i0, std::size_t mc, std::size_t p0, std::size_t kc,
+            double alpha, double* out) {
+    for (std::size_t ir = 0; ir < mc; ir += kMR) {
+        for (std::size_t p = 0; p < kc; ++p) {
+            for (std::size_t i = 0; i < kMR; ++i)
+                *out++ = ir + i < mc ? alpha * a(i0 + ir + i, p0 + p) : 0.0;
+        }
+    }
+}
+
+// B rows [p0, p0+kc) x cols [j0, j0+nc) as kNR-column strips.
+void pack_b(MatView<const double> b, std::size_t p0, std::size_t kc, std::size_t j0, std::size_t nc, double* out) {
+    for (std::size_t jr = 0; jr < nc; jr += kNR) {
+        const std::size_t n = std::min(kNR, nc - jr);
+        for (std::size_t p = 0; p < kc; ++p) {
+            const double* row = &b(p0 + p, j0 + jr);
+            std::size_t j = 0;
+            for (; j < n; ++j) *out++ = row[j];
+            for (; j < kNR; ++j) *out++ = 0.0;
+        }
+    }
+}
+
+} // namespace
+
+bool gemm(MatView<const double> a, MatView<const double> b, MatView<double> c,
+          double alpha, double beta, ThreadPool* pool) {
+    if (a.cols != b.rows || c.rows != a.rows || c.cols != b.cols) return false;
+    const std::size_t M = a.rows, N = b.cols, K = a.cols;
+
+    for (std::size_t r = 0; r < M; ++r) {
+        const auto row = c.row(r);
+        if (beta == 0.0) std::fill(row.begin(), row.end(), 0.0); // no NaN carry-over from C
+        else if (beta != 1.0) for (double& v : row) v *= beta;
+    }
+    if (alpha == 0.0 || K == 0 || M == 0 || N == 0) return true;
+
+    static const MicroKernel micro = pick_micro_kernel();
+    thread_local std::vector<double> b_pack;
+    const std::size_t panels = (M + kMC - 1) / kMC;
+
+    for (std::size_t jc = 0; jc < N; jc += kNC) {
+        const std::size_t nc = std::min(kNC, N - jc);
+        for (std::size_t pc = 0; pc < K; pc += kKC) {
+            const std::size_t kc = std::min(kKC, K - pc);
+            b_pack.resize(std::max(b_pack.size(), kc * round_up(nc, kNR)));
+            pack_b(b, pc, kc, jc, nc, b_pack.data());
+            const double* bp = b_pack.data();
+
+            auto row_panels = [&](std::size_t begin, std::size_t end, std::size_t) {
+                thread_local std::vector<double> a_pack;
+                a_pack.resize(std::max(a_pack.size(), kMC * kKC));
+                for (std::size_t panel = begin; panel < end; ++panel) {
+                    const std::size_t ic = panel * kMC, mc = std::min(kMC, M - ic);
+                    pack_a(a, ic, mc, pc, kc, alpha, a_pack.data());
+                    for (std::size_t jr = 0; jr < nc; jr += kNR) {
+                        const double* bs = bp + jr * kc;
+                        for (std::size_t ir = 0; ir < mc; ir += kMR) {
+                            const double* as = a_pack.data() + ir * kc;
+                            if (ir + kMR <= mc && jr + kNR <= nc) {
+                                micro(kc, as, bs, &c(ic + ir, jc + jr), c.stride);
+                                continue;
+                            }
+                            // edge tile: run it full size into scratch, add back the valid part
+                            double tile[kMR * kNR] = {};
+                            micro(kc, as, bs, tile, kNR);
+                            for (std::size_t i = 0; i < std::min(kMR, mc - ir); ++i)
+                                for (std::size_t j = 0; j < std::min(kNR, nc - jr); ++j)
+                                    c(ic + ir + i, jc + jr + j) += tile[i * kNR + j];
+                        }
+                    }
+                }
+            };
+            if (pool) pool->parallel_for(panels, 1, row_panels);
+            else row_panels(0, panels, 0);
+        }
+    }
+    return true;
+}
+
+bool gemv(MatView<const double> a, std::span<const double> x, std::span<double> y,
+          double alpha, double beta, ThreadPool& pool) {
+    if (x.size() != a.cols || y.size() != a.rows) return false;
+    pool.parallel_for(a.rows, 64, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t r = begin; r < end; ++r) {
+            const double ax = dot(a.data + r * a.stride, x.data(), a.cols);
+            y[r] = beta == 0.0 ? alpha * ax : alpha * ax + beta * y[r];
+        }
+    });
+    return true;
+}
+
+bool transform_cloud(const Mat4d& pose, MatView<const double> points, MatView<double> out, ThreadPool* pool) {
+    if (points.cols != 3 || out.cols != 3 || out.rows != points.rows) return false;
+    static const CloudKernel kernel = pick_cloud_kernel();
+    auto rows = [&](std::size_t begin, std::size_t end, std::size_t) { kernel(pose, points, out, begin, end); };
+    if (pool) pool->parallel_for(points.rows, 4096, rows);
+    else rows(0, points.rows, 0);
+    return true;
+}
+
+} // namespace robokit::linalg
@@ -0,0 +1,368 @@
+#include "robokit/hierarchical_planner.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace robokit {
+
+namespace {
+
+std::uint64_t abs_key(int f, int g) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(f)) << 32) | ~static_cast<std::uint32_t>(g);
+}
+
+// Bump a search stamp, clearing the stamp arrays once on wrap-around.
+void next_stamp(std::uint32_t& stamp, std::vector<std::uint32_t>& a, std::vector<std::uint32_t>& b) {
+    if (++stamp == 0) {
+        std::fill(a.begin(), a.end(), 0);
+        std::fill(b.begin(), b.end(), 0);
+        stamp = 1;
+    }
+}
+
+} // namespace
+
+HierarchicalPlanner::HierarchicalPlanner(Planner& planner, int sector_size)
+    : planner_(planner), sector_(std::max(2, sector_size)), w_(planner.width()), h_(planner.height()),
+      sectors_x_((w_ + sector_ - 1) / sector_), sectors_y_((h_ + sector_ - 1) / sector_) {
+    const auto n_local = static_cast<std::size_t>(sector_) * sector_;
+    local_g_.resize(n_local);
+    local_parent_.resize(n_local);
+    local_seen_.assign(n_local, 0);
+    local_closed_.assign(n_local, 0);
+    rebuild();
+}
+
+void HierarchicalPlanner::sector_rect(int s, int& x0, int& y0, int& x1, int& y1) const {
+    x0 = (s % sectors_x_) * sector_;
+    y0 = (s / sectors_x_) * sector_;
+    x1 = std::min(w_, x0 + sector_);
+    y1 = std::min(h_, y0 + sector_);
+}
+
+void HierarchicalPlanner::rebuild() {
+    const auto n = static_cast<std::size_t>(sectors_x_) * sectors_y_;
+    nodes_.clear();
+    free_ids_.clear();
+    node_of_cell_.clear();
+    sector_nodes_.assign(n, {});
+    borders_[Vertical].assign(n, {});
+    borders_[Horizontal].assign(n, {});
+    dirty_.assign(n, 1);
+    dirty_list_.resize(n);
+    for (std::size_t s = 0; s < n; ++s) dirty_list_[s] = static_cast<int>(s);
+    refresh();
+}
+
+void HierarchicalPlanner::update_cells(std::span<const CellChange> changes) {
+    planner_.set_cells(changes);
+    for (const auto& c : changes) {
+        if (!planner_.in_bounds(c.x, c.y)) continue;
+        const int s = sector_of(c.x, c.y);
+        if (!dirty_[s]) {
+            dirty_[s] = 1;
+            dirty_list_.push_back(s);
+        }
+    }
+}
+
+void HierarchicalPlanner::refresh() {
+    if (dirty_list_.empty()) return;
+    const auto n = static_cast<std::size_t>(sectors_x_) * sectors_y_;
+    std::vector<uint8_t> want(n, 0), done[2] = {std::vector<uint8_t>(n, 0), std::vector<uint8_t>(n, 0)};
+    std::vector<int> intra;
+    auto mark = [&](int s) { if (!want[s]) { want[s] = 1; intra.push_back(s); } };
+    auto border = [&](BorderKind kind, int b) {
+        if (done[kind][b]) return;
+        done[kind][b] = 1;
+        if (rebuild_border(kind, b)) {
+            mark(b);
+            mark(kind == Vertical ? b + 1 : b + sectors_x_);
+        }
+    };
+
+    // Entrances only depend on the two sectors sharing a border, so a dirty
+    // sector re-derives its four borders; neighbours are touched only when
+    // one of those borders actually changed.
+    for (int s : dirty_list_) {
+        mark(s);
+        const int cx = s % sectors_x_, cy = s / sectors_x_;
+        if (cx + 1 < sectors_x_) border(Vertical, s);
+        if (cx > 0) border(Vertical, s - 1);
+        if (cy + 1 < sectors_y_) border(Horizontal, s);
+        if (cy > 0) border(Horizontal, s - sectors_x_);
+        dirty_[s] = 0;
+    }
+    dirty_list_.clear();
+    for (int s : intra) rebuild_intra(s);
+}
+
+bool HierarchicalPlanner::rebuild_border(BorderKind kind, int s) {
+    int x0, y0, x1, y1;
+    sector_rect(s, x0, y0, x1, y1);
+    std::vector<Transition> fresh;
+    // along = position on the border, cells a/b on the near/far side
+    const int lo = kind == Vertical ? y0 : x0, hi = kind == Vertical ? y1 : x1;
+    auto cells = [&](int along, int& a, int& b) {
+        if (kind == Vertical) { a = along*w_ + x1 - 1; b = along*w_ + x1; }
+        else { a = (y1 - 1)*w_ + along; b = y1*w_ + along; }
+    };
+    auto open_at = [&](int along) {
+        return kind == Vertical ? planner_.free_cell(x1 - 1, along) && planner_.free_cell(x1, along)
+                                : planner_.free_cell(along, y1 - 1) && planner_.free_cell(along, y1);
+    };
+    for (int i = lo; i < hi;) {
+        if (!open_at(i)) { ++i; continue; }
+        int j = i;
+        while (j + 1 < hi && open_at(j + 1)) ++j;
+        int a, b;
+        if (j - i + 1 < kEntranceSplit) {
+            cells((i + j) / 2, a, b);
+            fresh.push_back({a, b});
+        } else {
+            cells(i, a, b);
+            fresh.push_back({a, b});
+            cells(j, a, b);
+            fresh.push_back({a, b});
+        }
+        i = j + 1;
+    }
+
+    auto& current = borders_[kind][s];
+    if (fresh == current) return false;
+    for (const auto& t : current) {
+        unlink(node_of_cell_.at(t.a), node_of_cell_.at(t.b));
+        release_node(t.a);
+        release_node(t.b);
+    }
+    for (const auto& t : fresh) {
+        const int a = acquire_node(t.a), b = acquire_node(t.b);
+        nodes_[a].edges.push_back({b, Planner::kStraightCost, true});
+        nodes_[b].edges.push_back({a, Planner::kStraightCost, true});
+    }
+    current = std::move(fresh);
+    return true;
+}
+
+int HierarchicalPlanner::acquire_node(int cell) {
+    if (auto it = node_of_cell_.find(cell); it != node_of_cell_.end()) {
+        ++nodes_[it->second].refs;
+        return it->second;
+    }
+    int id;
+    if (!free_ids_.empty()) {
+        id = free_ids_.back();
+        free_ids_.pop_back();
+    } else {
+        id = static_cast<int>(nodes_.size());
+        nodes_.emplace_back();
+    }
+    Node& n = nodes_[id];
+    n.cell = cell;
+    n.sector = sector_of(cell % w_, cell / w_);
+    n.refs = 1;
+    n.edges.clear();
+    node_of_cell_[cell] = id;
+    sector_nodes_[n.sector].push_back(id);
+    return id;
+}
+
+void HierarchicalPlanner::release_node(int cell) {
+    const int id = node_of_cell_.at(cell);
+    Node& n = nodes_[id];
+    if (--n.refs > 0) return;
+    // Intra edges pointing here are dropped when this sector's edges are rebuilt
+    // later in the same refresh, so the id can be recycled immediately.
+    auto& list = sector_nodes_[n.sector];
+    list.erase(std::find(list.begin(), list.end(), id));
+    node_of_cell_.erase(cell);
+    n.cell = -1;
+    n.edges.clear();
+    free_ids_.push_back(id);
+}
+
+void HierarchicalPlanner::unlink(int a, int b) {
+    auto drop = [](std::vector<Edge>& edges, int to) {
+        edges.erase(std::remove_if(edges.begin(), edges.end(),
+                                   [to](const Edge& e) { return e.inter && e.to == to; }),
+                    edges.end());
+    };
+    drop(nodes_[a].edges, b);
+    drop(nodes_[b].edges, a);
+}
+
+void HierarchicalPlanner::rebuild_intra(int s) {
+    ++sectors_rebuilt_;
+    const auto& ids = sector_nodes_[s];
+    for (int id : ids) {
+        auto& edges = nodes_[id].edges;
+        edges.erase(std::remove_if(edges.begin(), edges.end(), [](const Edge& e) { return !e.inter; }), edges.end());
+    }
+    for (int id : ids) {
+        local_search(s, nodes_[id].cell, -1);
+        for (int other : ids) {
+            if (other == id) continue;
+            const int c = local_cost(s, nodes_[other].cell);
+            if (c < kInf) nodes_[id].edges.push_back({other, c, false});
+        }
+    }
+}
+
+int HierarchicalPlanner::local_cost(int s, int cell) const {
+    int x0, y0, x1, y1;
+    sector_rect(s, x0, y0, x1, y1);
+    const int li = (cell / w_ - y0) * sector_ + (cell % w_ - x0);
+    return local_closed_[li] == local_stamp_ ? local_g_[li] : kInf;
+}
+
+int HierarchicalPlanner::local_search(int s, int src, int target) {
+    int x0, y0, x1, y1;
+    sector_rect(s, x0, y0, x1, y1);
+    next_stamp(local_stamp_, local_seen_, local_closed_);
+    const std::uint32_t stamp = local_stamp_;
+    auto local = [&](int x, int y) { return (y - y0) * sector_ + (x - x0); };
+
+    local_open_.clear();
+    const int sl = local(src % w_, src / w_);
+    local_seen_[sl] = stamp;
+    local_g_[sl] = 0;
+    local_parent_[sl] = -1;
+    local_open_.push(0, sl);
+    const int n_steps = planner_.step_count();
+    while (!local_open_.empty()) {
+        const int li = local_open_.pop().node;
+        if (local_closed_[li] == stamp) continue;
+        local_closed_[li] = stamp;
+        ++stats_.expanded;
+        const int x = x0 + li % sector_, y = y0 + li / sector_;
+        if (y*w_ + x == target) return local_g_[li];
+        for (int k = 0; k < n_steps; ++k) {
+            const int c = planner_.step_cost(x, y, k);
+            if (c == 0) continue;
+            const int nx = x + Planner::kSteps[k].dx, ny = y + Planner::kSteps[k].dy;
+            if (nx < x0 || nx >= x1 || ny < y0 || ny >= y1) continue;
+            const int nl = local(nx, ny);
+            if (local_closed_[nl] == stamp) continue;
+            const int ng = local_g_[li] + c;
+            if (local_seen_[nl] == stamp && ng >= local_g_[nl]) continue;
+            local_seen_[nl] = stamp;
+            local_g_[nl] = ng;
+            local_parent_[nl] = li;
+            local_open_.push(ng, nl);
+        }
+    }
+    return target < 0 ? 0 : kInf;
+}
+
+std::vector<std::pair<int,int>> HierarchicalPlanner::plan_waypoints(int sx, int sy, int gx, int gy) {
+    refresh();
+    stats_ = {};
+    if (!planner_.free_cell(sx, sy) || !planner_.free_cell(gx, gy)) return {};
+    const int start = sy*w_ + sx, goal = gy*w_ + gx;
+    if (start == goal) {
+        stats_.cost = 0;
+        return {{sx, sy}};
+    }
+    const int ss = sector_of(sx, sy), gs = sector_of(gx, gy);
+    if (ss == gs) {
+        const int c = local_search(ss, start, goal);
+        if (c < kInf) {
+            stats_.cost = c;
+            return {{sx, sy}, {gx, gy}};
+        }
+    }
+
+    // Virtual start/goal nodes connect to their sector's entrances.
+    const int n_nodes = static_cast<int>(nodes_.size());
+    const int vs = n_nodes, vg = n_nodes + 1;
+    std::vector<Edge> start_edges, goal_edges;
+    local_search(ss, start, -1);
+    for (int id : sector_nodes_[ss])
+        if (const int c = local_cost(ss, nodes_[id].cell); c < kInf) start_edges.push_back({id, c, false});
+    local_search(gs, goal, -1);
+    for (int id : sector_nodes_[gs])
+        if (const int c = local_cost(gs, nodes_[id].cell); c < kInf) goal_edges.push_back({id, c, false});
+
+    if (abs_g_.size() < static_cast<std::size_t>(n_nodes + 2)) {
+        abs_g_.resize(n_nodes + 2);
+        abs_parent_.resize(n_nodes + 2);
+        abs_seen_.resize(n_nodes + 2, 0);
+        abs_closed_.resize(n_nodes + 2, 0);
+    }
+    next_stamp(abs_stamp_, abs_seen_, abs_closed_);
+    const std::uint32_t stamp = abs_stamp_;
+    auto cell_of = [&](int v) { return v == vs ? start : v == vg ? goal : nodes_[v].cell; };
+    auto relax = [&](int from, int v, int ng) {
+        if (abs_closed_[v] == stamp || (abs_seen_[v] == stamp && ng >= abs_g_[v])) return;
+        abs_seen_[v] = stamp;
+        abs_g_[v] = ng;
+        abs_parent_[v] = from;
+        const int c = cell_of(v);
+        abs_open_.push(abs_key(ng + planner_.heuristic(c % w_, c / w_, gx, gy), ng), v);
+        ++stats_.pushed;
+    };
+
+    abs_open_.clear();
+    abs_seen_[vs] = stamp;
+    abs_g_[vs] = 0;
+    abs_parent_[vs] = -1;
+    abs_open_.push(abs_key(planner_.heuristic(sx, sy, gx, gy), 0), vs);
+    while (!abs_open_.empty()) {
+        const int u = abs_open_.pop().node;
+        if (abs_closed_[u] == stamp) continue;
+        abs_closed_[u] = stamp;
+        ++stats_.expanded;
+        if (u == vg) break;
+        const auto& edges = u == vs ? start_edges : nodes_[u].edges;
+        for (const auto& e : edges) relax(u, e.to, abs_g_[u] + e.cost);
+        if (u != vs && nodes_[u].sector == gs) {
+            for (const auto& e : goal_edges)
+                if (e.to == u) relax(u, vg, abs_g_[u] + e.cost);
+        }
+    }
+    if (abs_closed_[vg] != stamp) return {};
+
+    stats_.cost = abs_g_[vg];
+    std::vector<std::pair<int,int>> waypoints;
+    for (int v = vg; v >= 0; v = abs_parent_[v]) {
+        const int c = cell_of(v);
+        if (waypoints.empty() || waypoints.back() != std::make_pair(c % w_, c / w_)) waypoints.push_back({c % w_, c / w_});
+    }
+    std::reverse(waypoints.begin(), waypoints.end());
+    return waypoints;
+}
+
+std::vector<std::pair<int,int>> HierarchicalPlanner::refine(std::pair<int,int> from, std::pair<int,int> to) {
+    if (from == to) return {from};
+    const int dx = to.first - from.first, dy = to.second - from.second;
+    if (std::abs(dx) <= 1 && std::abs(dy) <= 1) {
+        for (int k = 0; k < planner_.step_count(); ++k) {
+            if (Planner::kSteps[k].dx == dx && Planner::kSteps[k].dy == dy && planner_.step_cost(from.first, from.second, k) > 0)
+                return {from, to};
+        }
+    }
+    const int s = sector_of(from.first, from.second);
+    if (s != sector_of(to.first, to.second)) return planner_.plan(from.first, from.second, to.first, to.second);
+
+    int x0, y0, x1, y1;
+    sector_rect(s, x0, y0, x1, y1);
+    if (local_search(s, from.second*w_ + from.first, to.second*w_ + to.first) >= kInf) return {};
+    std::vector<std::pair<int,int>> path;
+    for (int li = (to.second - y0) * sector_ + (to.first - x0); li >= 0; li = local_parent_[li])
+        path.push_back({x0 + li % sector_, y0 + li / sector_});
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::vector<std::pair<int,int>> HierarchicalPlanner::plan(int sx, int sy, int gx, int gy) {
+    const auto waypoints = plan_waypoints(sx, sy, gx, gy);
+    if (waypoints.empty()) return {};
+    std::vector<std::pair<int,int>> path{waypoints.front()};
+    for (std::size_t i = 1; i < waypoints.size(); ++i) {
+        const auto leg = refine(waypoints[i-1], waypoints[i]);
+        if (leg.empty()) return {};
+        path.insert(path.end(), leg.begin() + 1, leg.end());
+    }
+    return path;
+}
+
+} // namespace robokit
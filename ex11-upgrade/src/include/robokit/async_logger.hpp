@@ -0,0 +1,135 @@
+#pragma once
+#include "robokit/logging.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Asynchronous backend for robokit::log. While an AsyncLogger exists it is
+// the log sink: every thread that logs gets its own single-producer /
+// single-consumer ring of Records (registered on its first call), and one
+// background thread drains all rings, formats nothing itself and hands the
+// records to a BatchSink in batches. A log call on the hot path is then the
+// Record build plus one copy into the thread's ring: no lock, no allocation,
+// no system call, no I/O. A full ring drops the record (counted in
+// dropped()) rather than wait for the backend.
+
+namespace robokit::log {
+
+namespace detail {
+
+// SPSC ring of Records: push() on the logging thread, pop() on the backend.
+class RecordRing {
+public:
+    explicit RecordRing(std::size_t capacity)
+        : mask_(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity) - 1),
+          slots_(std::make_unique<Record[]>(mask_ + 1)) {}
+
+    RecordRing(const RecordRing&) = delete;
+    RecordRing& operator=(const RecordRing&) = delete;
+
+    // Producer side; false (and counted) when the ring is full.
+    bool push(const Record& r) {
+        const std::uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_cache_ > mask_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head - tail_cache_ > mask_) {
+                dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        slots_[head & mask_] = r;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: appends up to `max` records to `out`, oldest first.
+    std::size_t pop(std::vector<Record>& out, std::size_t max) {
+        const std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+        const std::uint64_t n = std::min<std::uint64_t>(head_.load(std::memory_order_acquire) - tail, max);
+        for (std::uint64_t i = 0; i < n; ++i) out.push_back(slots_[(tail + i) & mask_]);
+        tail_.store(tail + n, std::memory_order_release);
+        return static_cast<std::size_t>(n);
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    std::size_t mask_;
+    std::unique_ptr<Record[]> slots_;
+    // producer and consumer words on their own lines
+    alignas(64) std::atomic<std::uint64_t> head_{0};
+    std::uint64_t tail_cache_{0}; // producer's last view of tail_
+    std::atomic<std::uint64_t> dropped_{0};
+    alignas(64) std::atomic<std::uint64_t> tail_{0};
+};
+
+} // namespace detail
+
+struct AsyncLoggerOptions {
+    std::size_t ring_records{1024}; // per logging thread; rounded up to a power of two
+    std::size_t batch_records{256};  // most records per sink call
+    std::chrono::microseconds idle_poll{1000}; // backend sleep when every ring is empty
+    BatchSink sink{print_batch_sink};
+    void* context{nullptr};
+};
+
+// Installs itself with set_sink() on construction and puts the previous
+// default (print_sink) back on destruction, after delivering everything
+// still queued. Like set_sink(), create it before other threads start
+// logging and destroy it after they stop; one at a time. Records reach the
+// sink within about idle_poll; each thread's records arrive in the order
+// it logged them, and every batch is sorted by timestamp. Legacy
+// info/warn/error messages longer than Record::kTextBytes are cut here, as
+// with any custom sink.
+class AsyncLogger {
+public:
+    explicit AsyncLogger(AsyncLoggerOptions opts = {});
+    ~AsyncLogger();
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    // Blocks until every record logged (by any thread) before the call has
+    // been handed to the sink.
+    void flush();
+
+    // Records lost to full rings, over all threads.
+    std::uint64_t dropped() const;
+    // Records handed to the sink so far.
+    std::uint64_t delivered() const { return delivered_.load(std::memory_order_relaxed); }
+    // Threads that have logged through this logger.
+    std::size_t threads() const;
+
+private:
+    static void enqueue(const Record& r, void* context);
+    detail::RecordRing* add_ring();
+    void run(std::stop_token st);
+    std::size_t drain(std::vector<detail::RecordRing*>& rings, std::vector<Record>& batch);
+    void deliver(std::vector<Record>& batch);
+
+    AsyncLoggerOptions opts_;
+    std::uint64_t id_; // tells the thread-local ring caches of successive loggers apart
+
+    mutable std::mutex rings_mtx_;
+    std::vector<std::unique_ptr<detail::RecordRing>> rings_;
+
+    std::mutex wait_mtx_;
+    std::condition_variable_any wake_cv_; // backend: flush requested or stopping
+    std::condition_variable done_cv_;     // flush(): a drain pass finished
+    std::atomic<std::uint64_t> flush_requested_{0};
+    std::uint64_t flush_done_{0};
+    std::atomic<std::uint64_t> delivered_{0};
+
+    std::jthread thread_; // last: starts once everything above exists
+};
+
+} // namespace robokit::log
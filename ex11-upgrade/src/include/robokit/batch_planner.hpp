@@ -0,0 +1,92 @@
+#pragma once
+#include "robokit/planner.hpp"
+#include "robokit/thread_pool.hpp"
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace robokit {
+
+struct PlanQuery { int sx{}, sy{}, gx{}, gy{}; };
+
+// Where one query's path sits in BatchResult::cells.
+struct PathSpan {
+    std::uint32_t offset{};
+    std::uint32_t length{}; // 0: no path
+    int cost{-1};
+};
+
+// All paths of a batch in one flat buffer of row-major cell indices,
+// spans[i] belonging to query i. Reusing a result keeps its capacity.
+struct BatchResult {
+    int width{};
+    std::vector<std::uint32_t> cells;
+    std::vector<PathSpan> spans;
+
+    std::span<const std::uint32_t> path(std::size_t i) const {
+        return {cells.data() + spans[i].offset, spans[i].length};
+    }
+    std::pair<int,int> xy(std::uint32_t cell) const {
+        return {static_cast<int>(cell) % width, static_cast<int>(cell) / width};
+    }
+};
+
+struct BatchOptions {
+    std::size_t threads{0};     // including the caller; 0 = hardware concurrency
+    std::size_t share_goal{2};  // queries per goal before one reverse field serves them all
+};
+
+// Counters for the most recent BatchPlanner::plan() call.
+struct BatchStats {
+    std::size_t searches{};      // single-query A* runs
+    std::size_t shared_fields{}; // reverse Dijkstra fields, each serving a goal group
+    std::size_t expanded{};      // nodes expanded across all workers
+};
+
+// Answers many queries against one map snapshot. Queries sharing a goal are
+// served by a single reverse Dijkstra that stops once all their starts are
+// settled; the rest run A* (Planner::plan_into). Work items are spread over
+// a thread pool, each worker searching with its own scratch and appending to
+// its own buffer, and the buffers are stitched together in query order.
+// The planner must not be mutated while plan() runs.
+class BatchPlanner {
+public:
+    explicit BatchPlanner(Planner& planner, BatchOptions opts = {});
+
+    void plan(std::span<const PlanQuery> queries, BatchResult& out);
+    BatchResult plan(std::span<const PlanQuery> queries) {
+        BatchResult r;
+        plan(queries, r);
+        return r;
+    }
+
+    const BatchStats& last_stats() const { return stats_; }
+    std::size_t threads() const { return pool_.size(); }
+
+private:
+    struct Worker {
+        SearchScratch scratch;
+        PlannerStats stats;
+        std::vector<std::uint32_t> cells;
+        std::vector<int> targets;
+        BatchStats totals;
+    };
+    // Run of order_ entries handled together: one goal group or one query.
+    struct Job { std::uint32_t first, count; bool shared; };
+    struct Placement { std::uint32_t worker, offset, length; int cost; };
+
+    void run_job(const Job& job, std::span<const PlanQuery> queries, Worker& w, std::uint32_t wi);
+    int cell_of(int x, int y) const { return planner_.in_bounds(x, y) ? y*planner_.width() + x : -1; }
+
+    Planner& planner_;
+    BatchOptions opts_;
+    ThreadPool pool_;
+    std::vector<Worker> workers_;
+    std::vector<std::uint32_t> order_; // query ids grouped by goal
+    std::vector<Job> jobs_;
+    std::vector<Placement> placed_;
+    BatchStats stats_;
+};
+
+} // namespace robokit
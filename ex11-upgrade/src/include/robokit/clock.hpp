@@ -0,0 +1,47 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+
+namespace robokit {
+
+using SensorClock = std::chrono::steady_clock;
+using Timestamp = SensorClock::time_point;
+
+// Time source injected into Robot, its sensors and the control loop's
+// scheduler. Clock::steady() is the wall clock every component defaults to;
+// a VirtualClock makes the same code run on simulated time.
+class Clock {
+public:
+    virtual ~Clock() = default;
+    virtual Timestamp now() const = 0;
+    // Returns once now() >= tp.
+    virtual void sleep_until(Timestamp tp) = 0;
+
+    // Process-wide steady_clock instance.
+    static Clock& steady();
+};
+
+class SteadyClock final : public Clock {
+public:
+    Timestamp now() const override { return SensorClock::now(); }
+    void sleep_until(Timestamp tp) override; // absolute sleep, see sleep_until_abs()
+};
+
+// Simulated time: only moves when told to, and sleep_until() jumps straight
+// to the wake-up time instead of blocking. Readable from any thread; meant to
+// be advanced by one (see ControlLoop::simulate).
+class VirtualClock final : public Clock {
+public:
+    explicit VirtualClock(Timestamp start = Timestamp{}) : ns_(start.time_since_epoch().count()) {}
+    Timestamp now() const override { return Timestamp(Timestamp::duration(ns_.load(std::memory_order_acquire))); }
+    void sleep_until(Timestamp tp) override { advance_to(tp); }
+    // Never moves backwards.
+    void advance_to(Timestamp tp) {
+        if (tp > now()) ns_.store(tp.time_since_epoch().count(), std::memory_order_release);
+    }
+    void advance(Timestamp::duration d) { advance_to(now() + d); }
+private:
+    std::atomic<Timestamp::rep> ns_;
+};
+
+} // namespace robokit
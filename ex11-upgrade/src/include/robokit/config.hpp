@@ -1,47 +1,112 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
-#include <unordered_map>
-#include <fstream>
-#include <sstream>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace robokit {
 
-// Extremely naive config parser supporting lines key=value
-// and a pseudo JSON block { "key": number }
-// Insecure: no bounds checks, no escaping, no error reporting.
+// key=value config files, one entry per line. Lines starting with '#' and
+// blank lines are skipped; whitespace (CR included) around keys and values
+// is trimmed; a repeated key keeps its last value. Every line must be one
+// of those or key=value: anything else (the old `{ ... }` pseudo-JSON lines
+// included) makes the load report failure. Each load replaces the previous
+// contents rather than merging into them. Numbers take the forms std::stod
+// did (optional sign, decimal or 0x hex, inf / nan), but only if the whole
+// value parses: `1.5x` or `12 # comment` is a string, not 1.5 or 12, and an
+// out-of-range value is not a number either (no exception any more).
+//
+// load_file() maps the file read-only and tokenizes it in place: keys and
+// values are string_views into the mapping, and each value that parses as a
+// number in full (std::from_chars) is converted once, at load. Entries sit in
+// one array behind an open-addressing index keyed by string_view, so
+// get_number() in a hot loop is a hash and a probe or two: no allocation, no
+// std::string temporaries, no parsing.
 class Config {
 public:
-    bool load_file(const std::string& path) {
-        std::ifstream in(path); // no error check (intentional)
-        std::string line;
-        while (std::getline(in, line)) {
-            parse_line(line);
+    Config() = default;
+    ~Config() { unmap(); }
+    // Move-only: the views point into a mapping or buffer this object owns.
+    // Moving hands both over, so the views stay valid.
+    Config(const Config&) = delete;
+    Config& operator=(const Config&) = delete;
+    Config(Config&& o) noexcept { take(o); }
+    Config& operator=(Config&& o) noexcept {
+        if (this != &o) {
+            unmap();
+            take(o);
         }
-        return true; // always success
+        return *this;
     }
-    double get_number(const std::string& k, double def = 0.0) const {
-        auto it = data_.find(k);
-        if (it == data_.end()) return def;
-        return std::stod(it->second); // potential exception (ignored)
+
+    // Replaces the current contents. Returns false if the file cannot be read
+    // or has malformed lines (no '=' or an empty key); the well-formed lines
+    // are loaded either way and error_line() names the first bad one.
+    bool load_file(const std::string& path);
+    // Same, from text in memory (copied).
+    bool load_string(std::string_view text);
+
+    // `def` when the key is missing or its value is not a number.
+    double get_number(std::string_view k, double def = 0.0) const {
+        const Entry* e = find(k);
+        return e && e->is_number ? e->number : def;
     }
-    std::string get_string(const std::string& k, const std::string& def = "") const {
-        auto it = data_.find(k);
-        if (it == data_.end()) return def;
-        return it->second;
+    // The raw value: valid until the next load.
+    std::string_view get_view(std::string_view k, std::string_view def = {}) const {
+        const Entry* e = find(k);
+        return e ? e->text : def;
     }
+    std::string get_string(std::string_view k, const std::string& def = "") const {
+        const Entry* e = find(k);
+        return e ? std::string(e->text) : def;
+    }
+    bool contains(std::string_view k) const { return find(k) != nullptr; }
+
+    std::size_t size() const { return entries_.size(); }
+    // 1-based line of the first malformed line of the last load; 0 if none.
+    std::size_t error_line() const { return error_line_; }
     // TODO(CPP23): Return std::expected for robust error signaling.
 private:
-    void parse_line(const std::string& l) {
-        if (l.empty() || l[0] == '#') return;
-        auto pos = l.find('=');
-        if (pos != std::string::npos) {
-            data_[l.substr(0,pos)] = l.substr(pos+1);
-        } else if (l.find('{') != std::string::npos) {
-            // extremely naive; reads next token until }
-            // (example only, intentionally fragile)
+    struct Entry {
+        std::string_view key, text;
+        double number{};
+        bool is_number{};
+    };
+    static constexpr std::uint32_t kEmpty = ~std::uint32_t{0};
+
+    const Entry* find(std::string_view k) const {
+        if (slots_.empty()) return nullptr;
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t h = std::hash<std::string_view>{}(k) & mask; slots_[h] != kEmpty; h = (h + 1) & mask) {
+            const Entry& e = entries_[slots_[h]];
+            if (e.key == k) return &e;
         }
+        return nullptr;
+    }
+    bool parse(std::string_view text);
+    void insert(const Entry& e);
+    void unmap();
+    void take(Config& o) {
+        map_ = std::exchange(o.map_, nullptr);
+        mapped_ = std::exchange(o.mapped_, 0);
+        owned_ = std::move(o.owned_);
+        entries_ = std::move(o.entries_);
+        slots_ = std::move(o.slots_);
+        error_line_ = std::exchange(o.error_line_, 0);
+        o.owned_.clear();
+        o.entries_.clear();
+        o.slots_.clear();
     }
-    std::unordered_map<std::string,std::string> data_;
+
+    const char* map_{};      // file mapping behind the views, if mapped
+    std::size_t mapped_{};
+    std::vector<char> owned_; // text behind the views otherwise (heap, so moves keep it in place)
+    std::vector<Entry> entries_;        // one per distinct key, in file order
+    std::vector<std::uint32_t> slots_;  // linear probing into entries_; power-of-two size
+    std::size_t error_line_{};
 };
 
 } // namespace robokit
@@ -2,22 +2,65 @@
 #include "robokit/robot.hpp"
 #include "robokit/planner.hpp"
 #include "robokit/kinematics.hpp"
+#include "robokit/scheduler.hpp"
+#include "robokit/executor.hpp"
 #include <atomic>
+#include <chrono>
 #include <thread>
 #include <functional>
 
 namespace robokit {
 
+class TelemetryReader;
+
+struct ControlLoopOptions {
+    std::chrono::steady_clock::duration period{std::chrono::milliseconds(10)};
+    OverrunPolicy overrun{OverrunPolicy::Skip};
+    ExecutorOptions tasks{}; // workers for tasks registered via add_task()
+};
+
 class ControlLoop {
 public:
-    ControlLoop(Robot& robot, Planner& planner) : robot_(robot), planner_(planner) {}
-    void start(); // busy wait loop (intentional inefficiency)
+    ControlLoop(Robot& robot, Planner& planner, ControlLoopOptions opts = {})
+        : robot_(robot), planner_(planner), scheduler_(opts.period, opts.overrun, robot.clock()), tasks_(opts.tasks) {}
+    void start(); // sleeps on absolute deadlines (see DeadlineScheduler)
     void stop();
+    // Deterministic mode: advances the robot's VirtualClock by `span`, running
+    // the control body every period and the add_task() tasks at their
+    // releases, all on the calling thread and in time order (a task released
+    // at the same instant as a control tick runs after it). No sleeping, so a
+    // scenario runs as fast as the CPU allows and repeats bit for bit for
+    // fixed sensor seeds. Returns the control ticks run; 0 if the robot is on
+    // a real clock or the loop is running.
+    std::uint64_t simulate(std::chrono::steady_clock::duration span);
+    // Offline replay of a TelemetryWriter recording, under the same conditions
+    // as simulate() and with the same ordering. The clock first moves to the
+    // recording's origin, where the tasks are released; then for each frame it
+    // runs the add_task() tasks released before the frame's stamp, moves the
+    // clock there, loads the recorded joint state into the robot and runs the
+    // control body once; `after_tick(frame)` then sees the result (e.g. to
+    // diff it against frame + 1). Tasks can read the recorded sensors through
+    // ReplaySensor. Returns the frames replayed; 0 also when the recording's
+    // dof differs from the robot's.
+    std::uint64_t replay(const TelemetryReader& log, const std::function<void(std::uint64_t frame)>& after_tick = {});
+    // Extra periodic work (sensor polling, planning, logging) run beside the
+    // control body on the rate-monotonic executor. Register before start().
+    std::size_t add_task(std::string name, std::chrono::steady_clock::duration period, std::function<void()> fn) {
+        return tasks_.add_task(std::move(name), period, std::move(fn));
+    }
+    const RateMonotonicExecutor& tasks() const { return tasks_; }
+    bool running() const { return running_; }
+    // Jitter / overrun counters for the loop thread; safe to read while running.
+    const TimingStats& timing() const { return scheduler_.stats(); }
 private:
+    void tick();
+
     Robot& robot_;
     Planner& planner_;
+    DeadlineScheduler scheduler_;
+    RateMonotonicExecutor tasks_;
     std::atomic<bool> running_{false};
-    std::thread thread_;
+    std::jthread thread_;
 };
 
 } // namespace robokit
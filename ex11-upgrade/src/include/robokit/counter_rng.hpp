@@ -0,0 +1,39 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <span>
+
+namespace robokit {
+
+// Counter-based uniform generator on Philox4x32-10 (Salmon et al., SC'11).
+// Draw i is a pure function of (seed, i), so there is no state chain to
+// serialize: a batch fills every lane independently (AVX2 when the CPU has
+// it, picked at runtime) and gives exactly the values the same number of
+// single draws would, whatever the batch sizes.
+class CounterRng {
+public:
+    explicit CounterRng(std::uint64_t seed, std::uint64_t counter = 0) : key_(seed), counter_(counter) {}
+
+    // 52 random bits of draw `counter` under `key`.
+    static std::uint64_t bits(std::uint64_t key, std::uint64_t counter);
+    // Those bits as a mantissa of [1, 2), minus one: uniform in [0, 1). No
+    // integer-to-double conversion, which AVX2 lacks for 64-bit lanes.
+    static double unit(std::uint64_t bits) {
+        return std::bit_cast<double>(0x3FF0000000000000ull | bits) - 1.0;
+    }
+
+    // Uniform in [lo, hi).
+    double uniform(double lo, double hi) { return lo + (hi - lo) * unit(bits(key_, counter_++)); }
+    // out.size() consecutive draws, uniform in [lo, hi).
+    void uniform(std::span<double> out, double lo, double hi);
+
+    std::uint64_t seed() const { return key_; }
+    std::uint64_t counter() const { return counter_; }
+    void seek(std::uint64_t counter) { counter_ = counter; }
+
+private:
+    std::uint64_t key_;
+    std::uint64_t counter_;
+};
+
+} // namespace robokit
@@ -0,0 +1,85 @@
+#pragma once
+#include "robokit/clock.hpp"
+#include "robokit/scheduler.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace robokit {
+
+struct ExecutorOptions {
+    std::size_t workers{1};
+    std::vector<int> cpus;  // worker i pinned to cpus[i % cpus.size()]; empty = no pinning
+    bool realtime{false};   // request SCHED_FIFO (opt-in); falls back with a warning when not permitted
+    int rt_priority{10};    // FIFO priority of the slowest worker; faster workers get higher
+};
+
+// Rate-monotonic executor for periodic tasks (e.g. sensors @1kHz, planning @10Hz,
+// logging @1Hz). Tasks are sorted by period and split into contiguous rate bands,
+// one band per worker thread, so a worker's FIFO priority follows its fastest task.
+// Within a worker, due tasks run shortest-period first.
+class RateMonotonicExecutor {
+public:
+    using clock = std::chrono::steady_clock;
+
+    explicit RateMonotonicExecutor(ExecutorOptions opts = {});
+    ~RateMonotonicExecutor();
+
+    RateMonotonicExecutor(const RateMonotonicExecutor&) = delete;
+    RateMonotonicExecutor& operator=(const RateMonotonicExecutor&) = delete;
+
+    // Register before start(); returns a task id. Ignored (returns npos) while running.
+    std::size_t add_task(std::string name, clock::duration period, std::function<void()> fn);
+    void start();
+    void stop();
+    bool running() const { return !workers_.empty(); }
+
+    // Deterministic stepping for simulation, on the calling thread and only
+    // while not running(). sim_reset() releases every task one period after
+    // `start`; sim_run_until() then runs each release earlier than `end` in
+    // time order (ties: shorter period, then lower id), moving `clock` to the
+    // release first. Returns the number of task runs.
+    void sim_reset(clock::time_point start);
+    std::uint64_t sim_run_until(VirtualClock& clock, clock::time_point end);
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    std::size_t task_count() const { return tasks_.size(); }
+    const std::string& task_name(std::size_t id) const { return tasks_[id]->name; }
+    // Release lateness per activation; overruns() counts deadline misses,
+    // skipped() the releases dropped to recover from them.
+    const TimingStats& task_stats(std::size_t id) const { return tasks_[id]->stats; }
+
+    struct WorkerInfo {
+        std::size_t first_task{}, task_count{}; // slice of tasks in rate-monotonic order
+        int cpu{-1};          // -1 when unpinned or pinning failed
+        bool realtime{false}; // true only if SCHED_FIFO was actually applied
+    };
+    // Valid once start() has returned.
+    const std::vector<WorkerInfo>& workers() const { return info_; }
+
+private:
+    struct Task {
+        std::string name;
+        clock::duration period;
+        std::function<void()> fn;
+        clock::time_point next{};
+        TimingStats stats;
+    };
+    void run_worker(std::stop_token st, std::size_t w);
+
+    ExecutorOptions opts_;
+    std::vector<std::unique_ptr<Task>> tasks_; // id order
+    std::vector<Task*> order_;                 // rate-monotonic order, built by start()
+    std::vector<WorkerInfo> info_;
+    std::vector<std::jthread> workers_;
+    std::mutex mtx_;
+    std::condition_variable_any cv_; // only used as an interruptible absolute-time sleep
+};
+
+} // namespace robokit
@@ -0,0 +1,87 @@
+#pragma once
+#include "robokit/kinematics.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <utility>
+
+namespace robokit {
+
+// Largest DOF the runtime Kinematics / IkSolver paths specialize for.
+inline constexpr std::size_t kMaxFixedDof = 7;
+
+namespace detail {
+// f(integral_constant<0>) ... f(integral_constant<N-1>), expanded at compile time.
+template <std::size_t N, typename F>
+constexpr void unrolled(F&& f) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (f(std::integral_constant<std::size_t, I>{}), ...);
+    }(std::make_index_sequence<N>{});
+}
+} // namespace detail
+
+// Unit-link planar arm with the joint count fixed at compile time. Every
+// per-joint loop is expanded through detail::unrolled, and joint data lives
+// in std::array / fixed-extent spans, so an N-DOF chain is straight-line code
+// with no heap. Results are bit-identical to the runtime Kinematics, which
+// dispatches here for N = 2..kMaxFixedDof.
+template <std::size_t N>
+class FixedKinematics {
+    static_assert(N >= 1, "an arm needs at least one joint");
+public:
+    static constexpr std::size_t kDof = N;
+    using Joints = std::array<double, N>;
+    // Rows dx/dq, dy/dq; the dtheta/dq row is all ones.
+    using Jacobian = std::array<Joints, 2>;
+
+    // Cumulative link angles phi_i = q_0 + ... + q_i.
+    static constexpr Joints link_angles(std::span<const double, N> q) {
+        Joints phi{};
+        double acc = 0.0;
+        detail::unrolled<N>([&](auto i) { phi[i] = acc += q[i]; });
+        return phi;
+    }
+
+    // Forward kinematics that also keeps each link's cos/sin(phi_i).
+    static Pose2D forward(std::span<const double, N> q, std::span<double, N> c, std::span<double, N> s) {
+        const Joints phi = link_angles(q);
+        double x = 0.0, y = 0.0;
+        detail::unrolled<N>([&](auto i) {
+            c[i] = std::cos(phi[i]);
+            s[i] = std::sin(phi[i]);
+            x += c[i];
+            y += s[i];
+        });
+        return {x, y, phi[N - 1]};
+    }
+
+    static Pose2D forward(std::span<const double, N> q) {
+        Joints c, s;
+        return forward(q, c, s);
+    }
+
+    // Jacobian from the link cos/sin of forward(): dx/dq_j = -sum_{i>=j} sin(phi_i),
+    // dy/dq_j = sum_{i>=j} cos(phi_i), accumulated from the wrist inwards.
+    static constexpr void jacobian(std::span<const double, N> c, std::span<const double, N> s,
+                                   std::span<double, N> dx, std::span<double, N> dy) {
+        double sx = 0.0, sy = 0.0;
+        detail::unrolled<N>([&](auto k) {
+            constexpr std::size_t j = N - 1 - decltype(k)::value;
+            sx += s[j];
+            sy += c[j];
+            dx[j] = -sx;
+            dy[j] = sy;
+        });
+    }
+
+    static Jacobian jacobian(std::span<const double, N> q) {
+        Joints c, s;
+        forward(q, c, s);
+        Jacobian J;
+        jacobian(c, s, J[0], J[1]);
+        return J;
+    }
+};
+
+} // namespace robokit
@@ -0,0 +1,31 @@
+#pragma once
+#include "robokit/linalg.hpp"
+#include "robokit/thread_pool.hpp"
+#include <span>
+
+// Large dense kernels over MatView: cache-blocked, register-tiled GEMM, a
+// row-panel GEMV and a point-cloud transform, each optionally spread over a
+// ThreadPool by row panels. The fixed-size helpers in linalg.hpp stay the
+// tool for 3x3 / 4x4 work; these are for thousands of rows.
+
+namespace robokit::linalg {
+
+// C = alpha * A * B + beta * C. Blocks of B are packed once per (k, n)
+// block and shared; each row panel of A is packed by the worker that owns
+// it, so workers only write disjoint rows of C. Packing buffers are
+// thread-local and reused across calls. Returns false (C untouched) on a
+// dimension mismatch.
+bool gemm(MatView<const double> a, MatView<const double> b, MatView<double> c,
+          double alpha = 1.0, double beta = 0.0, ThreadPool* pool = nullptr);
+
+// y = alpha * A x + beta * y with rows split over `pool`.
+bool gemv(MatView<const double> a, std::span<const double> x, std::span<double> y,
+          double alpha, double beta, ThreadPool& pool);
+
+// out_i = R p_i + t for every row p_i of an N x 3 point matrix, where R and
+// t are the rotation and translation of a homogeneous pose. `out` may alias
+// `points`. Returns false if either view is not N x 3.
+bool transform_cloud(const Mat4d& pose, MatView<const double> points, MatView<double> out,
+                     ThreadPool* pool = nullptr);
+
+} // namespace robokit::linalg
@@ -0,0 +1,96 @@
+#pragma once
+#include "robokit/open_list.hpp"
+#include "robokit/planner.hpp"
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace robokit {
+
+// HPA* over a Planner's grid. The map is cut into square sectors; entrance
+// cells on each shared sector border become abstract nodes, linked across the
+// border and, inside a sector, by exact sector-local shortest distances.
+// Queries search the small abstract graph and hand back waypoints; each leg is
+// refined on demand with a search bounded to one sector. Paths are
+// near-optimal (entrances are sampled), not guaranteed optimal.
+class HierarchicalPlanner {
+public:
+    explicit HierarchicalPlanner(Planner& planner, int sector_size = 16);
+
+    // Full rebuild, e.g. after writing planner.grid() directly.
+    void rebuild();
+    // Apply changes through Planner::set_cells() and mark their sectors dirty;
+    // the abstract graph is patched per dirty sector on the next query.
+    void update_cells(std::span<const CellChange> changes);
+
+    // Abstract route start..goal: every consecutive pair lies in one sector or
+    // straddles a border, so refine() can expand it independently.
+    std::vector<std::pair<int,int>> plan_waypoints(int sx, int sy, int gx, int gy);
+    // Cell path for one leg returned by plan_waypoints().
+    std::vector<std::pair<int,int>> refine(std::pair<int,int> from, std::pair<int,int> to);
+    // Waypoints plus every leg refined.
+    std::vector<std::pair<int,int>> plan(int sx, int sy, int gx, int gy);
+
+    const PlannerStats& last_stats() const { return stats_; }
+    int sector_size() const { return sector_; }
+    std::size_t node_count() const { return node_of_cell_.size(); }
+    // Sectors whose intra-sector edges have been recomputed so far.
+    std::size_t sectors_rebuilt() const { return sectors_rebuilt_; }
+
+private:
+    static constexpr int kInf = 1 << 29;
+    static constexpr int kEntranceSplit = 6; // longer entrances get a node at each end
+
+    struct Edge { int to; int cost; bool inter; };
+    struct Node { int cell{-1}; int sector{-1}; int refs{0}; std::vector<Edge> edges; };
+    struct Transition {
+        int a, b; // cells either side of the border
+        bool operator==(const Transition&) const = default;
+    };
+    enum BorderKind { Vertical = 0, Horizontal = 1 }; // sector s | s+1, sector s over s+row
+
+    int sector_of(int x, int y) const { return (y / sector_) * sectors_x_ + x / sector_; }
+    void sector_rect(int s, int& x0, int& y0, int& x1, int& y1) const;
+    void refresh();
+    bool rebuild_border(BorderKind kind, int s);
+    int acquire_node(int cell);
+    void release_node(int cell);
+    void unlink(int a, int b);
+    void rebuild_intra(int s);
+    // Dijkstra inside sector s from `src`, stopping early at `target` (or -1
+    // for a full sweep). Returns the cost to target, kInf if unreachable.
+    int local_search(int s, int src, int target);
+    int local_cost(int s, int cell) const;
+
+    Planner& planner_;
+    int sector_, w_, h_, sectors_x_, sectors_y_;
+    std::vector<Node> nodes_;
+    std::vector<int> free_ids_;
+    std::unordered_map<int, int> node_of_cell_;
+    std::vector<std::vector<int>> sector_nodes_;
+    std::vector<std::vector<Transition>> borders_[2];
+    std::vector<uint8_t> dirty_;
+    std::vector<int> dirty_list_;
+    std::size_t sectors_rebuilt_{0};
+
+    // sector-local search scratch (sector_ x sector_ cells, stamped)
+    std::vector<int> local_g_;
+    std::vector<int> local_parent_;
+    std::vector<std::uint32_t> local_seen_;
+    std::vector<std::uint32_t> local_closed_;
+    std::uint32_t local_stamp_{0};
+    OpenList<int> local_open_;
+
+    // abstract search scratch (node ids + virtual start/goal, stamped)
+    std::vector<int> abs_g_;
+    std::vector<int> abs_parent_;
+    std::vector<std::uint32_t> abs_seen_;
+    std::vector<std::uint32_t> abs_closed_;
+    std::uint32_t abs_stamp_{0};
+    OpenList<std::uint64_t> abs_open_;
+    PlannerStats stats_;
+};
+
+} // namespace robokit
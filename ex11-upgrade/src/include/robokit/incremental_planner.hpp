@@ -0,0 +1,50 @@
+#pragma once
+#include "robokit/open_list.hpp"
+#include "robokit/planner.hpp"
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace robokit {
+
+// D* Lite over a Planner's grid (same connectivity and step costs). The search
+// runs backwards from the goal and keeps g/rhs values between calls, so after
+// update_cells() only vertices whose edges changed are repaired, and moving
+// the robot along the path costs nothing until the next change.
+class IncrementalPlanner {
+public:
+    explicit IncrementalPlanner(Planner& planner) : planner_(planner) {}
+
+    // Start a new search tree for this goal. False if either cell is off-grid.
+    bool reset(int sx, int sy, int gx, int gy);
+    // Robot moved; existing search state stays valid (keys shift by km).
+    void move_start(int sx, int sy);
+    // Apply occupancy changes through Planner::set_cells() and queue the
+    // affected vertices for repair. Use this instead of writing grid().
+    void update_cells(std::span<const CellChange> changes);
+    // Repair the search tree and return the path start..goal (empty if none).
+    std::vector<std::pair<int,int>> plan();
+
+    const PlannerStats& last_stats() const { return stats_; }
+    bool ready() const { return goal_ >= 0; }
+
+private:
+    static constexpr int kInf = 1 << 29;
+
+    std::uint64_t key(int u) const;
+    int h(int u) const;
+    void update_vertex(int u);
+    void compute_shortest_path();
+
+    Planner& planner_;
+    int w_{}, h_{};
+    int start_{-1}, goal_{-1}, last_{-1};
+    int km_{0};
+    std::vector<int> g_;
+    std::vector<int> rhs_;
+    OpenList<std::uint64_t> open_; // key = k1 << 32 | k2, stale entries skipped lazily
+    PlannerStats stats_;
+};
+
+} // namespace robokit
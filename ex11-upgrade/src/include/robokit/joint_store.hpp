@@ -0,0 +1,88 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace robokit {
+
+// One joint's state, by value (see JointStore::operator[]).
+struct JointState {
+    double position{}; // radians
+    double velocity{}; // radians/sec
+};
+
+// Joint state of a whole robot as structure of arrays: positions, velocities,
+// efforts and lower / upper position limits are each one contiguous array,
+// starting on a 64-byte boundary. An update over all joints is then a few
+// full-width vector operations per field (a 64-joint humanoid: 16 AVX2 or 8
+// AVX-512 ops) instead of strided loads over interleaved structs.
+class JointStore {
+public:
+    explicit JointStore(std::size_t dof = 0)
+        : dof_(dof), stride_((dof + kLane - 1) / kLane * kLane), data_(kFields * stride_ + kLane, 0.0) {
+        std::span<double> lo = lower_limits(), hi = upper_limits();
+        for (std::size_t j = 0; j < dof_; ++j) {
+            lo[j] = -std::numeric_limits<double>::infinity();
+            hi[j] = std::numeric_limits<double>::infinity();
+        }
+    }
+
+    // Copies re-align: a new buffer may start at a different offset from its line.
+    JointStore(const JointStore& o) : JointStore(o.dof_) { *this = o; }
+    JointStore& operator=(const JointStore& o) {
+        if (this == &o) return *this;
+        if (o.stride_ != stride_) {
+            dof_ = o.dof_;
+            stride_ = o.stride_;
+            data_.assign(kFields * stride_ + kLane, 0.0);
+        }
+        dof_ = o.dof_;
+        const double* src = o.data_.data() + o.first();
+        std::copy(src, src + kFields * stride_, data_.data() + first());
+        return *this;
+    }
+    JointStore(JointStore&&) noexcept = default;
+    JointStore& operator=(JointStore&&) noexcept = default;
+
+    std::size_t size() const { return dof_; }
+    bool empty() const { return dof_ == 0; }
+
+    std::span<double> positions() { return field(kPosition); }
+    std::span<const double> positions() const { return field(kPosition); }
+    std::span<double> velocities() { return field(kVelocity); }
+    std::span<const double> velocities() const { return field(kVelocity); }
+    std::span<double> efforts() { return field(kEffort); }
+    std::span<const double> efforts() const { return field(kEffort); }
+    // Unlimited (+-infinity) unless set.
+    std::span<double> lower_limits() { return field(kLower); }
+    std::span<const double> lower_limits() const { return field(kLower); }
+    std::span<double> upper_limits() { return field(kUpper); }
+    std::span<const double> upper_limits() const { return field(kUpper); }
+
+    JointState operator[](std::size_t j) const { return {positions()[j], velocities()[j]}; }
+    void set(std::size_t j, JointState s) {
+        positions()[j] = s.position;
+        velocities()[j] = s.velocity;
+    }
+
+private:
+    static constexpr std::size_t kLane = 8; // doubles per cache line
+    enum Field : std::size_t { kPosition, kVelocity, kEffort, kLower, kUpper, kFields };
+
+    // data_ is over-allocated by one line; fields start at its first 64-byte boundary
+    std::size_t first() const {
+        const auto addr = reinterpret_cast<std::uintptr_t>(data_.data());
+        return ((64 - addr % 64) % 64) / sizeof(double);
+    }
+    std::span<double> field(Field f) { return {data_.data() + first() + f * stride_, dof_}; }
+    std::span<const double> field(Field f) const { return {data_.data() + first() + f * stride_, dof_}; }
+
+    std::size_t dof_;
+    std::size_t stride_; // dof rounded up to whole cache lines
+    std::vector<double> data_;
+};
+
+} // namespace robokit
@@ -1,7 +1,10 @@
 #pragma once
+#include "robokit/linalg.hpp"
 #include <vector>
 #include <array>
+#include <cstddef>
 #include <optional>
+#include <span>
 
 namespace robokit {
 
@@ -9,10 +12,139 @@ namespace robokit {
 // TODO(CPP23): Replace with std::mdspan for matrix operations.
 struct Pose2D { double x{}, y{}, theta{}; };
 
+// Joint angles of `count` configurations as structure of arrays: joint j of
+// configuration i is angles[j * stride + i], so each joint is one contiguous
+// row across the batch. stride 0 means stride == count.
+struct JointBatch {
+    std::span<const double> angles;
+    std::size_t dof{};
+    std::size_t count{};
+    std::size_t stride{};
+};
+
+// Caller-owned pose outputs, at least `count` entries each.
+struct PoseBatch {
+    std::span<double> x, y, theta;
+};
+
+// sincos kernels forward_batch() can use, slowest first.
+enum class SimdLevel { Scalar, AVX2, AVX512 };
+
+// Elbow branch of the closed-form 2R/3R solutions: Up bends the elbow
+// clockwise (q2 <= 0), Down counter-clockwise (q2 >= 0).
+enum class Elbow { Up, Down };
+
+struct IkOptions {
+    double tolerance{1e-6};        // stop once the weighted pose error norm is below this
+    int max_iterations{100};
+    double damping{1e-3};          // initial DLS lambda; grows when a step fails, shrinks back after
+    double orientation_weight{1.0}; // 0 solves for position only
+};
+
+struct IkResult {
+    bool converged{};
+    int iterations{}; // Jacobian updates taken (0 if the seed already met the tolerance)
+    double error{};   // final weighted pose error norm
+};
+
+// Damped least squares IK for the unit-link planar arm:
+//   dq = J^T (J J^T + lambda^2 I)^-1 e
+// with a 3x3 solve per iteration, Levenberg-Marquardt style damping and
+// joint limits enforced by clamping each step. Every solve starts from the
+// previous solution, so tracking a slowly moving target converges in one or
+// two iterations. All buffers are fixed-size members; solve() never allocates.
+class IkSolver {
+public:
+    static constexpr std::size_t kMaxDof = 16;
+
+    // dof is clamped to [1, kMaxDof]. Joints start at zero, unlimited.
+    explicit IkSolver(std::size_t dof, IkOptions opts = {});
+
+    IkResult solve(const Pose2D& target);
+    // Replace the warm start (extra values ignored, missing ones zero).
+    void seed(std::span<const double> joints);
+    // Per-joint [lower, upper] limits; spans shorter than dof leave the rest unlimited.
+    void set_limits(std::span<const double> lower, std::span<const double> upper);
+
+    std::size_t dof() const { return dof_; }
+    std::span<const double> joints() const { return {q_.data(), dof_}; }
+    const IkOptions& options() const { return opts_; }
+    void set_options(const IkOptions& opts) { opts_ = opts; }
+
+private:
+    using Vec = std::array<double, kMaxDof>;
+    // N > 0: the FixedKinematics<N> path for dof_ == N; N == 0: runtime dof_.
+    template <std::size_t N>
+    IkResult solve_n(const Pose2D& target);
+    // Forward kinematics of q into the per-link sin/cos cache; returns the
+    // weighted error (target - pose) and its norm.
+    template <std::size_t N>
+    double pose_error(const Vec& q, const Pose2D& target, linalg::Vec3d& e, Vec& c, Vec& s) const;
+    void clamp(Vec& q) const;
+
+    std::size_t dof_;
+    IkOptions opts_;
+    Vec q_{};
+    Vec lower_, upper_;
+};
+
+// Forward kinematics that keeps each link's cumulative angle, sin/cos and
+// end position. Joint writes only mark the lowest changed joint; the next
+// pose() / link() query recomputes the chain from there outward, so moving
+// the wrist of an N-DOF arm costs one link update instead of N. Results are
+// bit-identical to Kinematics::forward().
+class FkCache {
+public:
+    explicit FkCache(std::size_t dof);
+
+    std::size_t dof() const { return q_.size(); }
+    double joint(std::size_t j) const { return q_[j]; }
+    // Writing the value a joint already has leaves the cache valid.
+    void set_joint(std::size_t j, double value);
+    // Set all joints (extra values ignored); only the first one that differs dirties the chain.
+    void set_joints(std::span<const double> q);
+
+    // End effector pose; recomputes links from the first dirty joint.
+    Pose2D pose();
+    // End of link i (theta = cumulative angle up to joint i).
+    Pose2D link(std::size_t i);
+    // Links recomputed since construction (each costs one sin/cos pair).
+    std::size_t links_updated() const { return links_updated_; }
+
+private:
+    void update();
+
+    struct Link { double phi, c, s, x, y; };
+    std::vector<double> q_;
+    std::vector<Link> links_;
+    std::size_t dirty_{0}; // first link whose cached values are stale
+    std::size_t links_updated_{0};
+};
+
 class Kinematics {
 public:
-    static Pose2D forward(const std::vector<double>& joint_positions);
-    static std::optional<std::vector<double>> inverse(const Pose2D& target, std::size_t dof);
+    static Pose2D forward(const std::vector<double>& joint_positions) {
+        return forward(std::span<const double>(joint_positions));
+    }
+    // E.g. forward(robot.joints().positions()), no copy.
+    static Pose2D forward(std::span<const double> joint_positions);
+    // forward() for every configuration of `joints`, written to `out`. Never
+    // allocates. Uses the widest sincos kernel up to `max_level` this CPU
+    // supports; returns false (writing nothing) if a span is too small.
+    static bool forward_batch(const JointBatch& joints, const PoseBatch& out,
+                              SimdLevel max_level = SimdLevel::AVX512);
+    // Widest kernel forward_batch() can run on this CPU / build.
+    static SimdLevel simd_level();
+    // Closed form for dof 2 (position only, target.theta is ignored) and 3;
+    // damped least squares from the zero pose otherwise (see IkSolver).
+    // nullopt if dof is 0 or above IkSolver::kMaxDof, or the pose is not reached.
+    static std::optional<std::vector<double>> inverse(const Pose2D& target, std::size_t dof,
+                                                      Elbow elbow = Elbow::Up);
+    // Law-of-cosines IK for the unit-link 2R arm: reaches (target.x, target.y).
+    static std::optional<std::array<double, 2>> inverse_2r(const Pose2D& target, Elbow elbow = Elbow::Up);
+    // 3R: the wrist sits one link back from the target along target.theta,
+    // the first two joints reach it as a 2R arm and q3 closes the angle.
+    static std::optional<std::array<double, 3>> inverse_3r(const Pose2D& target, Elbow elbow = Elbow::Up);
 };
 
 } // namespace robokit
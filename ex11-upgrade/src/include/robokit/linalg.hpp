@@ -0,0 +1,305 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#define ROBOKIT_LINALG_AVX2 1
+#include <immintrin.h>
+#endif
+
+// Small fixed-size linear algebra: Vec<T,N> / Mat<T,R,C> value types on
+// std::array storage (row-major), a MatView over caller-owned memory, and
+// fused kernels (mat-vec, mat-mat, A*A^T, 2D point transforms, gemv with
+// alpha/beta). Nothing here allocates. With ROBOKIT_ENABLE_AVX2 the double
+// 4x4 products, the point transform and gemv use AVX2/FMA; otherwise the
+// plain loops below, which the compiler unrolls for the fixed sizes.
+// TODO(CPP23): MatView becomes a std::mdspan alias.
+
+namespace robokit::linalg {
+
+template <typename T, std::size_t N>
+struct Vec {
+    std::array<T, N> v{};
+
+    static constexpr std::size_t size() { return N; }
+    constexpr T& operator[](std::size_t i) { return v[i]; }
+    constexpr const T& operator[](std::size_t i) const { return v[i]; }
+    constexpr T* data() { return v.data(); }
+    constexpr const T* data() const { return v.data(); }
+    constexpr std::span<T, N> span() { return v; }
+    constexpr std::span<const T, N> span() const { return v; }
+
+    constexpr Vec& operator+=(const Vec& o) { for (std::size_t i = 0; i < N; ++i) v[i] += o.v[i]; return *this; }
+    constexpr Vec& operator-=(const Vec& o) { for (std::size_t i = 0; i < N; ++i) v[i] -= o.v[i]; return *this; }
+    constexpr Vec& operator*=(T s) { for (auto& x : v) x *= s; return *this; }
+    friend constexpr Vec operator+(Vec a, const Vec& b) { return a += b; }
+    friend constexpr Vec operator-(Vec a, const Vec& b) { return a -= b; }
+    friend constexpr Vec operator*(Vec a, T s) { return a *= s; }
+    friend constexpr Vec operator*(T s, Vec a) { return a *= s; }
+    friend constexpr bool operator==(const Vec&, const Vec&) = default;
+};
+
+template <typename T, std::size_t N>
+constexpr T dot(const Vec<T, N>& a, const Vec<T, N>& b) {
+    T sum{};
+    for (std::size_t i = 0; i < N; ++i) sum += a[i] * b[i];
+    return sum;
+}
+
+template <typename T, std::size_t N>
+T norm(const Vec<T, N>& a) { return std::sqrt(dot(a, a)); }
+
+// Row-major R x C matrix.
+template <typename T, std::size_t R, std::size_t C>
+struct Mat {
+    std::array<T, R * C> m{};
+
+    static constexpr std::size_t rows() { return R; }
+    static constexpr std::size_t cols() { return C; }
+    constexpr T& operator()(std::size_t r, std::size_t c) { return m[r * C + c]; }
+    constexpr const T& operator()(std::size_t r, std::size_t c) const { return m[r * C + c]; }
+    constexpr T* data() { return m.data(); }
+    constexpr const T* data() const { return m.data(); }
+    constexpr std::span<T, C> row(std::size_t r) { return std::span<T, C>(m.data() + r * C, C); }
+    constexpr std::span<const T, C> row(std::size_t r) const { return std::span<const T, C>(m.data() + r * C, C); }
+
+    static constexpr Mat identity() requires (R == C) {
+        Mat I;
+        for (std::size_t i = 0; i < R; ++i) I(i, i) = T{1};
+        return I;
+    }
+
+    constexpr Mat& operator+=(const Mat& o) { for (std::size_t i = 0; i < R * C; ++i) m[i] += o.m[i]; return *this; }
+    constexpr Mat& operator*=(T s) { for (auto& x : m) x *= s; return *this; }
+    friend constexpr Mat operator+(Mat a, const Mat& b) { return a += b; }
+    friend constexpr Mat operator*(Mat a, T s) { return a *= s; }
+    friend constexpr bool operator==(const Mat&, const Mat&) = default;
+};
+
+using Vec2d = Vec<double, 2>;
+using Vec3d = Vec<double, 3>;
+using Vec4d = Vec<double, 4>;
+using Mat2d = Mat<double, 2, 2>;
+using Mat3d = Mat<double, 3, 3>;
+using Mat4d = Mat<double, 4, 4>;
+
+template <typename T, std::size_t R, std::size_t C>
+constexpr Mat<T, C, R> transpose(const Mat<T, R, C>& a) {
+    Mat<T, C, R> t;
+    for (std::size_t r = 0; r < R; ++r)
+        for (std::size_t c = 0; c < C; ++c) t(c, r) = a(r, c);
+    return t;
+}
+
+// A * x
+template <typename T, std::size_t R, std::size_t C>
+constexpr Vec<T, R> operator*(const Mat<T, R, C>& a, const Vec<T, C>& x) {
+    Vec<T, R> y;
+#ifdef ROBOKIT_LINALG_AVX2
+    if constexpr (std::is_same_v<T, double> && R == 4 && C == 4) {
+        if (!std::is_constant_evaluated()) {
+            // y = sum_c column(c) * x[c]; columns gathered from the row-major rows
+            const __m256d r0 = _mm256_loadu_pd(a.data()), r1 = _mm256_loadu_pd(a.data() + 4);
+            const __m256d r2 = _mm256_loadu_pd(a.data() + 8), r3 = _mm256_loadu_pd(a.data() + 12);
+            const __m256d xv = _mm256_loadu_pd(x.data());
+            const __m256d p0 = _mm256_mul_pd(r0, xv), p1 = _mm256_mul_pd(r1, xv);
+            const __m256d p2 = _mm256_mul_pd(r2, xv), p3 = _mm256_mul_pd(r3, xv);
+            // horizontal sums of p0..p3 into one vector
+            const __m256d s01 = _mm256_hadd_pd(p0, p1), s23 = _mm256_hadd_pd(p2, p3);
+            const __m256d lo = _mm256_permute2f128_pd(s01, s23, 0x20), hi = _mm256_permute2f128_pd(s01, s23, 0x31);
+            _mm256_storeu_pd(y.data(), _mm256_add_pd(lo, hi));
+            return y;
+        }
+    }
+#endif
+    for (std::size_t r = 0; r < R; ++r) {
+        T sum{};
+        for (std::size_t c = 0; c < C; ++c) sum += a(r, c) * x[c];
+        y[r] = sum;
+    }
+    return y;
+}
+
+// A^T * x without forming the transpose.
+template <typename T, std::size_t R, std::size_t C>
+constexpr Vec<T, C> transpose_mul(const Mat<T, R, C>& a, const Vec<T, R>& x) {
+    Vec<T, C> y;
+    for (std::size_t r = 0; r < R; ++r)
+        for (std::size_t c = 0; c < C; ++c) y[c] += a(r, c) * x[r];
+    return y;
+}
+
+// A * B
+template <typename T, std::size_t R, std::size_t K, std::size_t C>
+constexpr Mat<T, R, C> operator*(const Mat<T, R, K>& a, const Mat<T, K, C>& b) {
+    Mat<T, R, C> out;
+#ifdef ROBOKIT_LINALG_AVX2
+    if constexpr (std::is_same_v<T, double> && R == 4 && K == 4 && C == 4) {
+        if (!std::is_constant_evaluated()) {
+            // row r of the result = sum_k a(r,k) * row k of b
+            const __m256d b0 = _mm256_loadu_pd(b.data()), b1 = _mm256_loadu_pd(b.data() + 4);
+            const __m256d b2 = _mm256_loadu_pd(b.data() + 8), b3 = _mm256_loadu_pd(b.data() + 12);
+            for (std::size_t r = 0; r < 4; ++r) {
+                const double* ar = a.data() + r * 4;
+                __m256d acc = _mm256_mul_pd(_mm256_set1_pd(ar[0]), b0);
+                acc = _mm256_fmadd_pd(_mm256_set1_pd(ar[1]), b1, acc);
+                acc = _mm256_fmadd_pd(_mm256_set1_pd(ar[2]), b2, acc);
+                acc = _mm256_fmadd_pd(_mm256_set1_pd(ar[3]), b3, acc);
+                _mm256_storeu_pd(out.data() + r * 4, acc);
+            }
+            return out;
+        }
+    }
+#endif
+    for (std::size_t r = 0; r < R; ++r)
+        for (std::size_t k = 0; k < K; ++k) {
+            const T ark = a(r, k);
+            for (std::size_t c = 0; c < C; ++c) out(r, c) += ark * b(k, c);
+        }
+    return out;
+}
+
+// A * A^T (symmetric), using only the first `cols` columns of A; cols = C by
+// default, smaller when trailing columns are unused padding.
+template <typename T, std::size_t R, std::size_t C>
+constexpr Mat<T, R, R> mul_transposed(const Mat<T, R, C>& a, std::size_t cols = C) {
+    Mat<T, R, R> g;
+    for (std::size_t i = 0; i < R; ++i)
+        for (std::size_t j = i; j < R; ++j) {
+            T sum{};
+            for (std::size_t c = 0; c < cols; ++c) sum += a(i, c) * a(j, c);
+            g(i, j) = g(j, i) = sum;
+        }
+    return g;
+}
+
+template <typename T>
+constexpr T abs_value(T v) { return v < T{} ? -v : v; }
+
+// Solve A x = b by Gaussian elimination with partial pivoting. Returns false
+// (x untouched) if A is singular to working precision.
+template <typename T, std::size_t N>
+constexpr bool solve(Mat<T, N, N> a, Vec<T, N> b, Vec<T, N>& x) {
+    for (std::size_t k = 0; k < N; ++k) {
+        std::size_t p = k;
+        for (std::size_t r = k + 1; r < N; ++r)
+            if (abs_value(a(r, k)) > abs_value(a(p, k))) p = r;
+        if (!(abs_value(a(p, k)) > std::numeric_limits<T>::min())) return false;
+        if (p != k) {
+            for (std::size_t c = k; c < N; ++c) std::swap(a(k, c), a(p, c));
+            std::swap(b[k], b[p]);
+        }
+        for (std::size_t r = k + 1; r < N; ++r) {
+            const T f = a(r, k) / a(k, k);
+            for (std::size_t c = k; c < N; ++c) a(r, c) -= f * a(k, c);
+            b[r] -= f * b[k];
+        }
+    }
+    for (std::size_t k = N; k-- > 0;) {
+        T sum = b[k];
+        for (std::size_t c = k + 1; c < N; ++c) sum -= a(k, c) * x[c];
+        x[k] = sum / a(k, k);
+    }
+    return true;
+}
+
+// Homogeneous 2D rigid transform: rotate by theta, then translate by (x, y).
+inline Mat3d rigid2d(double x, double y, double theta) {
+    const double c = std::cos(theta), s = std::sin(theta);
+    Mat3d t;
+    t(0, 0) = c; t(0, 1) = -s; t(0, 2) = x;
+    t(1, 0) = s; t(1, 1) = c;  t(1, 2) = y;
+    t(2, 2) = 1.0;
+    return t;
+}
+
+// Non-owning row-major view of a rows x cols matrix, `stride` elements apart
+// from one row to the next (stride >= cols).
+template <typename T>
+struct MatView {
+    T* data{};
+    std::size_t rows{}, cols{}, stride{};
+
+    MatView() = default;
+    MatView(T* d, std::size_t r, std::size_t c, std::size_t s = 0) : data(d), rows(r), cols(c), stride(s ? s : c) {}
+    template <typename U, std::size_t R, std::size_t C>
+    MatView(Mat<U, R, C>& m) : MatView(m.data(), R, C) {}
+    template <typename U, std::size_t R, std::size_t C>
+    MatView(const Mat<U, R, C>& m) : MatView(m.data(), R, C) {}
+    // const view of a mutable one
+    template <typename U>
+    MatView(const MatView<U>& o) requires std::is_same_v<const U, T>
+        : data(o.data), rows(o.rows), cols(o.cols), stride(o.stride) {}
+
+    T& operator()(std::size_t r, std::size_t c) const { return data[r * stride + c]; }
+    std::span<T> row(std::size_t r) const { return {data + r * stride, cols}; }
+};
+
+// Dot product of n contiguous elements; four partial sums so the loop
+// pipelines (and vectorizes with AVX2) without reassociation flags.
+inline double dot(const double* a, const double* b, std::size_t n) {
+    std::size_t i = 0;
+#ifdef ROBOKIT_LINALG_AVX2
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = acc0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), acc0);
+        acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), acc1);
+    }
+    const __m256d acc = _mm256_add_pd(acc0, acc1);
+    const __m128d half = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+    double sum = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+#else
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    double sum = (s0 + s1) + (s2 + s3);
+#endif
+    for (; i < n; ++i) sum += a[i] * b[i];
+    return sum;
+}
+
+// y = alpha * A x + beta * y. Returns false (y untouched) on a size mismatch.
+inline bool gemv(MatView<const double> a, std::span<const double> x, std::span<double> y,
+                 double alpha = 1.0, double beta = 0.0) {
+    if (x.size() != a.cols || y.size() != a.rows) return false;
+    for (std::size_t r = 0; r < a.rows; ++r) {
+        const double ax = dot(a.data + r * a.stride, x.data(), a.cols);
+        y[r] = beta == 0.0 ? alpha * ax : alpha * ax + beta * y[r];
+    }
+    return true;
+}
+
+// Apply a 2D homogeneous transform to points held as structure of arrays.
+// Outputs may alias the inputs. Returns false on a size mismatch.
+inline bool transform_points(const Mat3d& t, std::span<const double> xs, std::span<const double> ys,
+                             std::span<double> out_x, std::span<double> out_y) {
+    const std::size_t n = xs.size();
+    if (ys.size() != n || out_x.size() != n || out_y.size() != n) return false;
+    std::size_t i = 0;
+#ifdef ROBOKIT_LINALG_AVX2
+    const __m256d m00 = _mm256_set1_pd(t(0, 0)), m01 = _mm256_set1_pd(t(0, 1)), m02 = _mm256_set1_pd(t(0, 2));
+    const __m256d m10 = _mm256_set1_pd(t(1, 0)), m11 = _mm256_set1_pd(t(1, 1)), m12 = _mm256_set1_pd(t(1, 2));
+    for (; i + 4 <= n; i += 4) {
+        const __m256d x = _mm256_loadu_pd(xs.data() + i), y = _mm256_loadu_pd(ys.data() + i);
+        _mm256_storeu_pd(out_x.data() + i, _mm256_fmadd_pd(m00, x, _mm256_fmadd_pd(m01, y, m02)));
+        _mm256_storeu_pd(out_y.data() + i, _mm256_fmadd_pd(m10, x, _mm256_fmadd_pd(m11, y, m12)));
+    }
+#endif
+    for (; i < n; ++i) {
+        const double x = xs[i], y = ys[i];
+        out_x[i] = t(0, 0) * x + t(0, 1) * y + t(0, 2);
+        out_y[i] = t(1, 0) * x + t(1, 1) * y + t(1, 2);
+    }
+    return true;
+}
+
+} // namespace robokit::linalg
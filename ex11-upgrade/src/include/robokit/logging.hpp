@@ -1,26 +1,210 @@
 #pragma once
-#include <iostream>
-#include <mutex>
+#include "robokit/clock.hpp"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Structured logging with a compile-time severity threshold and interned
+// format strings. ROBOKIT_LOG_INFO("planned {} cells in {} ms", n, ms):
+//  - compiles to nothing (arguments unevaluated) below ROBOKIT_LOG_LEVEL;
+//  - checks at compile time that the literal's {} placeholders match the
+//    argument count (std::format syntax, {} and {{ }} only);
+//  - registers the literal once per call site and afterwards only packs the
+//    site id and the raw argument values into a fixed-size Record, which
+//    goes to the current sink. Formatting happens in the sink, if at all.
+// The default sink still prints synchronously under a global mutex
+// (intentional anti-pattern, see README); an AsyncLogger (async_logger.hpp)
+// moves formatting and I/O off the logging threads.
+
+#ifndef ROBOKIT_LOG_LEVEL
+#define ROBOKIT_LOG_LEVEL 1 // Info; set by the ROBOKIT_LOG_LEVEL CMake cache variable
+#endif
 
-// Simple global logger (intentional anti-pattern)
 namespace robokit::log {
 
-inline std::mutex g_log_mutex; // global state
+enum class Level : std::uint8_t { Debug = 0, Info = 1, Warn = 2, Error = 3, Off = 4 };
 
-inline void info(const char* msg) {
-    std::lock_guard<std::mutex> lk(g_log_mutex);
-    std::cout << "[INFO] " << msg << '\n';
-}
+inline constexpr Level kMinLevel = static_cast<Level>(ROBOKIT_LOG_LEVEL);
+constexpr bool enabled(Level l) { return l >= kMinLevel && l != Level::Off; }
+
+using FormatId = std::uint32_t;
+
+// One registered call site. Ids are dense, starting at 0, in registration order.
+struct Site {
+    const char* format{};
+    const char* file{};
+    int line{};
+    Level level{};
+};
+
+// Registers a call site; the macros call it once per site. Thread-safe.
+FormatId intern(Level level, const char* format, const char* file, int line);
+// Lock-free lookups; valid for ids returned by intern().
+const Site& site(FormatId id);
+std::size_t site_count();
+
+enum class ArgType : std::uint8_t { Bool, Char, Int, UInt, Double, String, Pointer };
+
+// Fixed-size binary log entry. String arguments are copied into `text`;
+// once kTextBytes are used the rest is cut off and `truncated` is set. Each
+// string keeps its original length, so format() marks exactly the cut ones
+// with "...". Everything else is stored raw.
+struct Record {
+    static constexpr std::size_t kMaxArgs = 8;
+    static constexpr std::size_t kTextBytes = 128;
+    union Value {
+        bool b;
+        char c;
+        std::int64_t i;
+        std::uint64_t u;
+        double d;
+        struct { std::uint16_t offset, size; std::uint32_t length; } s; // slice of text; length before the cut
+        const void* p;
+    };
+
+    Timestamp stamp{};
+    FormatId id{};
+    Level level{};
+    std::uint8_t arg_count{};
+    std::uint16_t text_size{};
+    bool truncated{};
+    // only the first arg_count / text_size entries are meaningful; the rest
+    // is left uninitialized so building a record does not clear ~200 bytes
+    std::array<ArgType, kMaxArgs> types;
+    std::array<Value, kMaxArgs> args;
+    std::array<char, kTextBytes> text;
+};
+
+// Renders a record with its site's format string.
+std::string format(const Record& r);
+
+// Receives every record that passes the compile-time filter, on the logging
+// thread. Set before logging starts; not synchronized with emit().
+using Sink = void (*)(const Record& r, void* context);
+void set_sink(Sink sink, void* context = nullptr);
+// The default: "[INFO] message" to stdout (stderr for errors), mutex-guarded.
+void print_sink(const Record& r, void* context);
+
+// Receives records in groups, on AsyncLogger's background thread.
+using BatchSink = void (*)(std::span<const Record> records, void* context);
+// print_sink's output for a whole batch, one locked write per stream.
+void print_batch_sink(std::span<const Record> records, void* context);
 
-inline void warn(const char* msg) {
-    std::lock_guard<std::mutex> lk(g_log_mutex);
-    std::cout << "[WARN] " << msg << '\n';
+namespace detail {
+
+// Not constexpr: reaching it while checking a format string at compile time
+// turns the bad literal into a compile error that names the problem.
+void invalid_format_string_or_argument_count();
+
+consteval std::size_t count_placeholders(std::string_view f) {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < f.size(); ++i) {
+        if (f[i] == '{') {
+            if (i + 1 < f.size() && f[i + 1] == '{') { ++i; continue; }
+            if (i + 1 < f.size() && f[i + 1] == '}') { ++i; ++n; continue; }
+            invalid_format_string_or_argument_count(); // specs and indices are not supported
+        } else if (f[i] == '}') {
+            if (i + 1 < f.size() && f[i + 1] == '}') { ++i; continue; }
+            invalid_format_string_or_argument_count(); // unmatched '}'
+        }
+    }
+    return n;
 }
 
-inline void error(const char* msg) {
-    std::lock_guard<std::mutex> lk(g_log_mutex);
-    std::cerr << "[ERR ] " << msg << '\n';
+template <typename T>
+concept StringLike = std::convertible_to<const T&, std::string_view>;
+
+template <typename T>
+concept Loggable = StringLike<T> || std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+template <typename T>
+void pack(Record& r, const T& v) {
+    const std::size_t k = r.arg_count++;
+    auto& out = r.args[k];
+    if constexpr (StringLike<T>) {
+        const std::string_view sv(v);
+        const std::size_t n = std::min(sv.size(), Record::kTextBytes - r.text_size);
+        if (n < sv.size()) r.truncated = true;
+        sv.copy(r.text.data() + r.text_size, n);
+        r.types[k] = ArgType::String;
+        out.s = {r.text_size, static_cast<std::uint16_t>(n),
+                 static_cast<std::uint32_t>(std::min<std::size_t>(sv.size(), UINT32_MAX))};
+        r.text_size = static_cast<std::uint16_t>(r.text_size + n);
+    } else if constexpr (std::is_same_v<T, bool>) {
+        r.types[k] = ArgType::Bool;
+        out.b = v;
+    } else if constexpr (std::is_same_v<T, char>) {
+        r.types[k] = ArgType::Char;
+        out.c = v;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        r.types[k] = ArgType::Double;
+        out.d = static_cast<double>(v);
+    } else if constexpr (std::is_enum_v<T>) {
+        r.types[k] = ArgType::Int;
+        out.i = static_cast<std::int64_t>(v);
+    } else if constexpr (std::is_pointer_v<T>) {
+        r.types[k] = ArgType::Pointer;
+        out.p = v;
+    } else if constexpr (std::is_signed_v<T>) {
+        r.types[k] = ArgType::Int;
+        out.i = v;
+    } else {
+        r.types[k] = ArgType::UInt;
+        out.u = v;
+    }
 }
 
-// TODO(CPP23): Replace with std::print + structured severity & sinks.
+void dispatch(const Record& r);
+
+} // namespace detail
+
+// A format string literal checked against Args at compile time.
+template <typename... Args>
+struct FormatString {
+    const char* str;
+    consteval FormatString(const char* s) : str(s) {
+        if (detail::count_placeholders(s) != sizeof...(Args)) detail::invalid_format_string_or_argument_count();
+    }
+};
+
+template <typename... Args>
+    requires (sizeof...(Args) <= Record::kMaxArgs && (detail::Loggable<std::decay_t<Args>> && ...))
+void emit(Level level, FormatId id, FormatString<std::type_identity_t<Args>...>, const Args&... args) {
+    Record r;
+    r.stamp = SensorClock::now();
+    r.id = id;
+    r.level = level;
+    (detail::pack<std::decay_t<const Args&>>(r, args), ...);
+    detail::dispatch(r);
 }
+
+// Legacy entry points for runtime strings; same filtering, one "{}" site
+// each. With the default sink a message of any length is printed whole; a
+// custom sink gets a Record, which holds at most Record::kTextBytes of it
+// (see Record::truncated).
+void info(std::string_view msg);
+void warn(std::string_view msg);
+void error(std::string_view msg);
+
+// TODO(CPP23): std::print in print_sink.
+} // namespace robokit::log
+
+#define ROBOKIT_LOG_AT(level, fmt, ...)                                                              \
+    do {                                                                                             \
+        if constexpr (::robokit::log::enabled(level)) {                                              \
+            static const ::robokit::log::FormatId robokit_log_id_ =                                  \
+                ::robokit::log::intern(level, fmt, __FILE__, __LINE__);                              \
+            ::robokit::log::emit(level, robokit_log_id_, fmt __VA_OPT__(, ) __VA_ARGS__);            \
+        }                                                                                            \
+    } while (0)
+
+#define ROBOKIT_LOG_DEBUG(fmt, ...) ROBOKIT_LOG_AT(::robokit::log::Level::Debug, fmt __VA_OPT__(, ) __VA_ARGS__)
+#define ROBOKIT_LOG_INFO(fmt, ...) ROBOKIT_LOG_AT(::robokit::log::Level::Info, fmt __VA_OPT__(, ) __VA_ARGS__)
+#define ROBOKIT_LOG_WARN(fmt, ...) ROBOKIT_LOG_AT(::robokit::log::Level::Warn, fmt __VA_OPT__(, ) __VA_ARGS__)
+#define ROBOKIT_LOG_ERROR(fmt, ...) ROBOKIT_LOG_AT(::robokit::log::Level::Error, fmt __VA_OPT__(, ) __VA_ARGS__)
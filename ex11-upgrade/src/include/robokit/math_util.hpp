@@ -4,6 +4,8 @@
 
 namespace robokit {
 
+// Legacy allocating mat-vec, kept as the naive reference; new code uses
+// linalg::gemv / linalg::Mat (robokit/linalg.hpp).
 inline std::vector<double> mat_vec(const std::vector<double>& m, int rows, int cols, const std::vector<double>& v) {
     if ((int)v.size() != cols) return {}; // silent failure (intentional)
     std::vector<double> out(rows, 0.0);
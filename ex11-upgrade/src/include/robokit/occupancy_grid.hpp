@@ -0,0 +1,98 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace robokit {
+
+// Flat bitset used as packed visited/closed sets. Remembers which words it
+// has set bits in, so reset() to the same size clears only those: a short
+// search on a large grid costs its own footprint, not cells / 64 stores.
+class BitSet {
+public:
+    // Size for `bits` entries, all cleared (keeps storage if the size matches).
+    void reset(std::size_t bits) {
+        const std::size_t n = (bits + 63) / 64;
+        if (words_.size() == n) {
+            for (const std::uint32_t w : touched_) words_[w] = 0;
+        } else {
+            words_.assign(n, 0);
+        }
+        touched_.clear();
+    }
+    bool test(std::size_t i) const { return (words_[i >> 6] >> (i & 63)) & 1u; }
+    void set(std::size_t i) {
+        std::uint64_t& w = words_[i >> 6];
+        if (w == 0) touched_.push_back(static_cast<std::uint32_t>(i >> 6));
+        w |= std::uint64_t{1} << (i & 63);
+    }
+    std::size_t memory_bytes() const {
+        return words_.size() * sizeof(std::uint64_t) + touched_.capacity() * sizeof(std::uint32_t);
+    }
+private:
+    std::vector<std::uint64_t> words_;
+    std::vector<std::uint32_t> touched_; // indices of non-zero words, each once
+};
+
+// Occupancy at 1 bit per cell (1 = blocked), stored as 8x8 tiles with one
+// uint64_t per tile and tiles in row-major order. A 3x3 neighbourhood usually
+// sits inside a single word, so neighbour tests are a few shifts instead of
+// eight byte loads. Cells outside the grid read as blocked.
+class OccupancyGrid {
+public:
+    static constexpr int kTile = 8;
+
+    OccupancyGrid() = default;
+    OccupancyGrid(int w, int h);
+    // Pack a row-major byte grid (non-zero = blocked).
+    static OccupancyGrid from_bytes(int w, int h, const std::vector<std::uint8_t>& bytes);
+    void to_bytes(std::vector<std::uint8_t>& out) const;
+
+    int width() const { return w_; }
+    int height() const { return h_; }
+    bool in_bounds(int x, int y) const { return x >= 0 && x < w_ && y >= 0 && y < h_; }
+
+    bool blocked(int x, int y) const {
+        if (!in_bounds(x, y)) return true;
+        return (tiles_[tile_index(x, y)] >> bit_index(x, y)) & 1u;
+    }
+    void set(int x, int y, bool blocked);
+
+    // Blocked neighbours of (x,y) as an 8-bit mask, bit k for the step
+    // E, W, S, N, SE, NE, SW, NW (k = 0..7; +y is "south").
+    std::uint8_t blocked_neighbors(int x, int y) const;
+
+    std::uint64_t tile(int tx, int ty) const { return tiles_[static_cast<std::size_t>(ty) * tiles_x_ + tx]; }
+    std::size_t memory_bytes() const { return tiles_.size() * sizeof(std::uint64_t); }
+
+private:
+    std::size_t tile_index(int x, int y) const {
+        return static_cast<std::size_t>(y / kTile) * tiles_x_ + static_cast<std::size_t>(x / kTile);
+    }
+    static int bit_index(int x, int y) { return (y % kTile) * kTile + (x % kTile); }
+
+    int w_{}, h_{}, tiles_x_{}, tiles_y_{};
+    std::vector<std::uint64_t> tiles_;
+};
+
+// Legal-move mask for a blocked-neighbour mask (same bit order). Straight
+// moves need the target free; diagonals also need both orthogonals free.
+constexpr std::array<std::uint8_t, 256> make_legal_moves() {
+    std::array<std::uint8_t, 256> t{};
+    for (int m = 0; m < 256; ++m) {
+        auto free_at = [m](int k) { return ((m >> k) & 1) == 0; };
+        int legal = 0;
+        for (int k = 0; k < 4; ++k) if (free_at(k)) legal |= 1 << k;
+        if (free_at(4) && free_at(0) && free_at(2)) legal |= 1 << 4; // SE
+        if (free_at(5) && free_at(0) && free_at(3)) legal |= 1 << 5; // NE
+        if (free_at(6) && free_at(1) && free_at(2)) legal |= 1 << 6; // SW
+        if (free_at(7) && free_at(1) && free_at(3)) legal |= 1 << 7; // NW
+        t[m] = static_cast<std::uint8_t>(legal);
+    }
+    return t;
+}
+inline constexpr std::array<std::uint8_t, 256> kLegalMoves = make_legal_moves();
+
+} // namespace robokit
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace robokit {
+
+// Flat binary min-heap of (key, node index) entries for grid searches.
+// clear() keeps capacity so a planner can reuse it across queries; callers do
+// lazy decrease-key (push again, skip stale entries on pop).
+template <typename Key>
+class OpenList {
+public:
+    struct Entry { Key key; int node; };
+
+    void clear() { heap_.clear(); }
+    void reserve(std::size_t n) { heap_.reserve(n); }
+    bool empty() const { return heap_.empty(); }
+    std::size_t size() const { return heap_.size(); }
+    std::size_t capacity() const { return heap_.capacity(); }
+    const Entry& top() const { return heap_.front(); }
+
+    void push(Key key, int node) {
+        heap_.push_back({key, node});
+        std::size_t i = heap_.size() - 1;
+        while (i > 0) {
+            std::size_t p = (i - 1) / 2;
+            if (!(heap_[i].key < heap_[p].key)) break;
+            std::swap(heap_[i], heap_[p]);
+            i = p;
+        }
+    }
+
+    Entry pop() {
+        Entry out = heap_.front();
+        heap_.front() = heap_.back();
+        heap_.pop_back();
+        const std::size_t n = heap_.size();
+        std::size_t i = 0;
+        for (;;) {
+            std::size_t l = 2 * i + 1, r = l + 1, m = i;
+            if (l < n && heap_[l].key < heap_[m].key) m = l;
+            if (r < n && heap_[r].key < heap_[m].key) m = r;
+            if (m == i) break;
+            std::swap(heap_[i], heap_[m]);
+            i = m;
+        }
+        return out;
+    }
+
+private:
+    std::vector<Entry> heap_;
+};
+
+} // namespace robokit
@@ -1,4 +1,8 @@
 #pragma once
+#include "robokit/occupancy_grid.hpp"
+#include "robokit/open_list.hpp"
+#include <optional>
+#include <span>
 #include <vector>
 #include <string>
 #include <utility>
@@ -8,18 +12,199 @@ namespace robokit {
 
 struct GridNode { int x{}, y{}; int cost{}; };
 
+enum class PlannerMode {
+    BFS,   // original uninformed search (returns the goal cell only)
+    AStar, // heuristic search with full path reconstruction
+    JPS,   // jump point search over cached cardinal jumps (Eight only, else A*)
+    FlowField // whole-grid distance + direction field per goal, reused across starts
+};
+
+enum class Connectivity {
+    Four,  // N/E/S/W moves, Manhattan heuristic
+    Eight  // adds diagonals (no corner cutting), octile heuristic
+};
+
+enum class GridStorage {
+    Bytes,  // one byte per cell, row-major; grid() is the live store
+    Packed  // OccupancyGrid bits + packed visited sets (~8x less occupancy memory)
+};
+
+struct PlannerOptions {
+    PlannerMode mode{PlannerMode::AStar};
+    Connectivity connectivity{Connectivity::Four};
+    GridStorage storage{GridStorage::Bytes};
+};
+
+// One occupancy update, applied with Planner::set_cells().
+struct CellChange { int x{}, y{}; uint8_t value{}; };
+
+// Counters for the most recent plan() call.
+struct PlannerStats {
+    std::size_t expanded{}; // nodes popped and expanded
+    std::size_t pushed{};   // open-list insertions
+    int cost{-1};           // path cost in Planner::kStraightCost units, -1 if no path
+};
+
+// Per-search buffers. Planner owns one for plan(); concurrent const queries
+// (plan_into / settle_from) each bring their own, e.g. one per worker thread.
+// A cell's g/parent entries are only meaningful while seen[i] == search_id
+// (or seen_bits is set in Packed mode), so nothing is cleared between queries
+// beyond the bitset words the previous query set.
+struct SearchScratch {
+    std::vector<std::uint32_t> seen;
+    std::vector<std::uint32_t> closed;
+    std::vector<int> g;
+    std::vector<int> parent;
+    BitSet seen_bits;   // Packed mode stand-ins for seen/closed
+    BitSet closed_bits;
+    OpenList<std::uint64_t> open;
+    std::uint32_t search_id{0};
+
+    std::size_t memory_bytes() const;
+};
+
 class Planner {
 public:
-    Planner(int w, int h);
-    // returns path as list of (x,y)
+    static constexpr int kStraightCost = 10;
+    static constexpr int kDiagonalCost = 14; // ~10*sqrt(2), keeps octile consistent
+
+    struct Step { int dx, dy, cost; };
+    // 4-connected moves first, then diagonals
+    static constexpr Step kSteps[8] = {
+        {1,0,kStraightCost}, {-1,0,kStraightCost}, {0,1,kStraightCost}, {0,-1,kStraightCost},
+        {1,1,kDiagonalCost}, {1,-1,kDiagonalCost}, {-1,1,kDiagonalCost}, {-1,-1,kDiagonalCost},
+    };
+
+    Planner(int w, int h, PlannerOptions opts = {});
+    // returns path as list of (x,y) from start to goal inclusive; empty if
+    // unreachable, out of bounds or blocked
     std::vector<std::pair<int,int>> plan(int sx, int sy, int gx, int gy);
 
-    // direct mutable access (unsafe) to occupancy grid
-    std::vector<uint8_t>& grid() { return grid_; }
-    const std::vector<uint8_t>& grid() const { return grid_; }
+    int width() const { return w_; }
+    int height() const { return h_; }
+    bool in_bounds(int x, int y) const { return x >= 0 && x < w_ && y >= 0 && y < h_; }
+    bool free_cell(int x, int y) const {
+        return in_bounds(x, y) && (packed() ? !cells_.blocked(x, y) : grid_[y*w_ + x] == 0);
+    }
+    bool packed() const { return opts_.storage == GridStorage::Packed; }
+    int step_count() const { return opts_.connectivity == Connectivity::Four ? 4 : 8; }
+    // Cost of moving from (x,y) by step k (0 if blocked or corner-cutting).
+    int step_cost(int x, int y, int k) const;
+    // Admissible distance estimate for the configured connectivity.
+    int heuristic(int x, int y, int gx, int gy) const;
+    const PlannerOptions& options() const { return opts_; }
+    // Switching storage converts the occupancy in place.
+    void set_options(const PlannerOptions& opts);
+    const PlannerStats& last_stats() const { return stats_; }
+
+    // Thread-safe A* (plan()'s JPS/BFS modes are not used here) against
+    // caller-owned scratch; appends the start..goal cell indices to `out`.
+    // Call prepare() after the last mutation and before fanning out.
+    bool plan_into(int sx, int sy, int gx, int gy, SearchScratch& scratch, PlannerStats& stats,
+                   std::vector<std::uint32_t>& out) const;
+    // Thread-safe reverse Dijkstra from `goal`, stopping once every cell in
+    // `targets` (sorted, unique) is settled. Parent links then lead to the goal.
+    void settle_from(int goal, std::span<const int> targets, SearchScratch& scratch, PlannerStats& stats) const;
+    // Append the cells from `start` up the settle_from() tree to its root.
+    bool trace_settled(const SearchScratch& scratch, int start, std::vector<std::uint32_t>& out) const;
+    // Distance transform from (gx,gy) over the whole grid plus a direction
+    // field pointing downhill. Kept until the goal, map or connectivity
+    // changes, so every robot heading to the same goal shares one build.
+    // Returns false (and clears the field) if the goal is blocked.
+    bool build_flow_field(int gx, int gy);
+    // Cost to the flow-field goal, -1 if unreachable or no field.
+    int flow_distance(int x, int y) const;
+    // Next cell towards the flow-field goal; nullopt at the goal or if unreachable.
+    std::optional<std::pair<int,int>> flow_next(int x, int y) const;
+    // Row sweeps the last build needed to converge.
+    int flow_sweeps() const { return flow_sweeps_; }
+    // Fold pending grid() writes into the packed store before const queries.
+    void prepare() { sync_storage(); }
+    // Packed occupancy (valid in GridStorage::Packed mode).
+    const OccupancyGrid& cells() const { return cells_; }
+    // Bytes held by occupancy, search scratch and derived caches.
+    std::size_t memory_bytes() const;
+
+    // Preferred mutation path: keeps derived planner caches (JPS jump table)
+    // valid by invalidating only the rows/columns the cell can affect.
+    void set_cell(int x, int y, uint8_t value);
+    void set_cells(std::span<const CellChange> changes) {
+        for (const auto& c : changes) set_cell(c.x, c.y, c.value);
+    }
+    // Drop all derived caches; call after bulk writes through grid().
+    void invalidate() {
+        caches_stale_ = true;
+        flow_stale_ = true;
+        if (packed() && !grid_.empty()) bytes_dirty_ = true;
+    }
+
+    // direct mutable access (unsafe) to occupancy grid; conservatively
+    // invalidates derived caches since the caller may write through it.
+    // In Packed mode this materializes a byte mirror that is re-packed and
+    // freed on the next plan()/set_cell()/prepare(), which also ends the
+    // reference's lifetime.
+    std::vector<uint8_t>& grid();
+    // A copy of the occupancy as bytes (pending grid() writes included);
+    // never touches the planner, so it is safe next to concurrent queries.
+    std::vector<uint8_t> grid() const;
 private:
+    std::vector<std::pair<int,int>> plan_bfs(int sx, int sy, int gx, int gy);
+    std::vector<std::pair<int,int>> plan_astar(int sx, int sy, int gx, int gy);
+    template <typename Cells, typename Visited, typename Target>
+    void best_first(const Cells& cells, Visited& visited, SearchScratch& s, PlannerStats& stats,
+                    int start, Target& target) const;
+    template <typename Target>
+    void run_search(SearchScratch& s, PlannerStats& stats, int start, Target& target) const;
+    std::vector<std::pair<int,int>> plan_jps(int sx, int sy, int gx, int gy);
+    // JPS helpers (planner_jps.cpp)
+    void jps_prepare();
+    void jps_rebuild_row(int y);
+    void jps_rebuild_col(int x);
+    int jps_straight(int x, int y, int dir, int goal);
+    int jps_diagonal(int x, int y, int dx, int dy, int goal);
+    std::vector<std::pair<int,int>> plan_flow(int sx, int sy, int gx, int gy);
+    // flow-field helpers (planner_flow.cpp)
+    void flow_load_occupancy();
+    void flow_directions();
+    void sync_storage();
+    void reserve_scratch(SearchScratch& s) const;
+    void begin_search(SearchScratch& s) const;
+    void begin_packed_search(SearchScratch& s) const;
+    bool closed(const SearchScratch& s, int cell) const;
+    // open-list key: f in the high word, ~g low so ties prefer deeper nodes
+    static std::uint64_t open_key(int f, int g) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(f)) << 32) | ~static_cast<std::uint32_t>(g);
+    }
+    std::vector<std::pair<int,int>> reconstruct(const SearchScratch& s, int goal) const;
+
     int w_, h_;
-    std::vector<uint8_t> grid_; // 0 free, 1 obstacle
+    PlannerOptions opts_;
+    std::vector<uint8_t> grid_; // 0 free, 1 obstacle (Packed: empty unless handed out by grid())
+    OccupancyGrid cells_;       // authoritative in Packed mode
+    bool bytes_dirty_{false};   // Packed: grid_ was handed out for writing
+
+    SearchScratch scratch_; // sized on first use and reused by every plan()
+    PlannerStats stats_;
+
+    // JPS+ style cardinal jump table, 4 entries per cell (E, W, S, N). Entry
+    // d > 0: next jump point d cells away; d <= 0: -d free cells, then a wall.
+    // Rows feed E/W entries and columns S/N; each is rebuilt lazily when dirty.
+    std::vector<int> jump_;
+    std::vector<uint8_t> jump_row_dirty_;
+    std::vector<uint8_t> jump_col_dirty_;
+    bool caches_stale_{true};
+
+    // Flow field over a grid padded by one wall cell on every side, so the
+    // sweeps need no bounds checks. flow_dist_ holds chamfer costs
+    // (kStraightCost / kDiagonalCost), flow_dir_ a kSteps index per
+    // (unpadded) cell, 0xFF where there is no next step.
+    std::vector<int> flow_dist_;
+    std::vector<uint8_t> flow_open_;
+    std::vector<uint8_t> flow_dir_;
+    int flow_goal_{-1};
+    int flow_sweeps_{0};
+    std::size_t flow_cells_relaxed_{0};
+    bool flow_stale_{true};
 };
 
 } // namespace robokit
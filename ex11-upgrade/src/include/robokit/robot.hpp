@@ -1,42 +1,71 @@
 #pragma once
+#include "robokit/clock.hpp"
+#include "robokit/joint_store.hpp"
+#include "robokit/robot_state.hpp"
 #include <vector>
 #include <string>
 #include <cstdint>
 #include <memory>
+#include <span>
 
 namespace robokit {
 
-struct JointState {
-    double position{}; // radians
-    double velocity{}; // radians/sec
-};
-
 class SensorBase {
 public:
     virtual ~SensorBase() = default;
     virtual const char* name() const = 0;
     virtual double read() = 0; // simplistic single value
+    // Fills min(values.size(), stamps.size()) samples in one call and returns
+    // that count. The default loops over read(), stamping each with now();
+    // sensor models override it to produce the whole batch at once.
+    virtual std::size_t read_batch(std::span<double> values, std::span<Timestamp> stamps);
+
+    // Time source for sample stamps and time-driven models; Robot::add_sensor
+    // hands over the robot's clock.
+    const Clock& clock() const { return *clock_; }
+    void set_clock(const Clock& clock) { clock_ = &clock; }
+protected:
+    Timestamp now() const { return clock_->now(); }
+private:
+    const Clock* clock_ = &Clock::steady();
 };
 
 class Robot {
 public:
-    explicit Robot(std::string name, std::size_t dof);
+    explicit Robot(std::string name, std::size_t dof, Clock& clock = Clock::steady());
     ~Robot(); // manual cleanup (intentional raw new usage)
 
     Robot(const Robot&) = delete;
     Robot& operator=(const Robot&) = delete;
 
     const std::string& name() const { return name_; }
-    std::vector<JointState>& joints() { return joints_; }
-    const std::vector<JointState>& joints() const { return joints_; }
+    // Structure of arrays; pass its spans straight to kernels. Owned by the
+    // thread that drives the robot (the ControlLoop while it runs); other
+    // threads read state() instead.
+    JointStore& joints() { return joints_; }
+    const JointStore& joints() const { return joints_; }
+
+    // Publishes joints() stamped with clock().now(); ControlLoop calls it
+    // after every control tick.
+    void publish_state() { state_.publish(clock_->now(), joints_); }
+    // Torn-free snapshots of the last publish, from any thread:
+    //   RobotState s; if (robot.state().read(s)) use(s.joints.positions());
+    const StatePublisher& state() const { return state_; }
+
+    // Shared by the sensors and any ControlLoop driving this robot; a
+    // VirtualClock here enables ControlLoop::simulate().
+    Clock& clock() const { return *clock_; }
+    void set_clock(Clock& clock);
 
     void add_sensor(SensorBase* s); // raw pointer ownership (intentional)
     std::vector<SensorBase*> sensors() const { return sensors_; } // returns copy of raw pointers
 
 private:
     std::string name_;
-    std::vector<JointState> joints_;
+    JointStore joints_;
+    StatePublisher state_;
     std::vector<SensorBase*> sensors_;
+    Clock* clock_;
 };
 
 } // namespace robokit
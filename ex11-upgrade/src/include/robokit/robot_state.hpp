@@ -0,0 +1,87 @@
+#pragma once
+#include "robokit/clock.hpp"
+#include "robokit/joint_store.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace robokit {
+
+// A consistent copy of a robot's published state. Only positions, velocities
+// and efforts are published; the limits of `joints` stay unlimited.
+struct RobotState {
+    Timestamp stamp{};
+    std::uint64_t sequence{}; // 1 for the first publish, +1 per publish
+    JointStore joints;
+};
+
+// Seqlock publication of joint state: one writer (the control thread) calls
+// publish() once per tick, any number of readers call read() from any
+// thread. The writer never waits for readers; a reader whose copy overlapped
+// a publish retries, so it never sees a mix of two ticks. Values are stored
+// as relaxed atomics, so this is race-free under the C++ memory model (and
+// TSan), yet compiles to plain loads and stores.
+class StatePublisher {
+public:
+    explicit StatePublisher(std::size_t dof)
+        : dof_(dof), values_(std::make_unique<std::atomic<double>[]>(kFields * dof)) {}
+
+    std::size_t dof() const { return dof_; }
+    // Publishes so far (0: read() has nothing to return yet).
+    std::uint64_t published() const { return seq_.load(std::memory_order_acquire) / 2; }
+
+    // Writer side; call from one thread only. Extra joints are ignored.
+    void publish(Timestamp stamp, const JointStore& joints) {
+        const std::uint64_t s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        stamp_.store(stamp.time_since_epoch().count(), std::memory_order_relaxed);
+        const std::size_t n = std::min(dof_, joints.size());
+        store(0, joints.positions().first(n));
+        store(1, joints.velocities().first(n));
+        store(2, joints.efforts().first(n));
+        seq_.store(s + 2, std::memory_order_release);
+    }
+
+    // Copies the newest published state into `out` (resizing out.joints on
+    // first use). Returns false, leaving `out` alone, before the first publish.
+    bool read(RobotState& out) const {
+        if (out.joints.size() != dof_) out.joints = JointStore(dof_);
+        for (;;) {
+            const std::uint64_t s = seq_.load(std::memory_order_acquire);
+            if (s == 0) return false;
+            if (s & 1) continue; // publish in progress
+            const auto stamp = stamp_.load(std::memory_order_relaxed);
+            load(0, out.joints.positions());
+            load(1, out.joints.velocities());
+            load(2, out.joints.efforts());
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) != s) continue; // overlapped a publish
+            out.stamp = Timestamp(Timestamp::duration(stamp));
+            out.sequence = s / 2;
+            return true;
+        }
+    }
+
+private:
+    static constexpr std::size_t kFields = 3;
+
+    void store(std::size_t field, std::span<const double> v) {
+        std::atomic<double>* dst = values_.get() + field * dof_;
+        for (std::size_t j = 0; j < v.size(); ++j) dst[j].store(v[j], std::memory_order_relaxed);
+    }
+    void load(std::size_t field, std::span<double> v) const {
+        const std::atomic<double>* src = values_.get() + field * dof_;
+        for (std::size_t j = 0; j < v.size(); ++j) v[j] = src[j].load(std::memory_order_relaxed);
+    }
+
+    std::size_t dof_;
+    std::unique_ptr<std::atomic<double>[]> values_;
+    std::atomic<Timestamp::rep> stamp_{0};
+    alignas(64) std::atomic<std::uint64_t> seq_{0}; // odd while a publish is in progress
+};
+
+} // namespace robokit
@@ -0,0 +1,121 @@
+#pragma once
+#include "robokit/clock.hpp"
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+
+namespace robokit {
+
+struct Sample {
+    Timestamp stamp{};
+    double value{};
+};
+
+// Per-consumer read position into a SampleRing. `next` is the sequence
+// number of the next sample wanted; `dropped` counts samples the producer
+// overwrote before this consumer got to them.
+struct SampleCursor {
+    std::uint64_t next{0};
+    std::uint64_t dropped{0};
+};
+
+// Single-producer / multi-consumer ring of timestamped samples. push() never
+// blocks or waits on readers: a slow consumer simply loses the oldest
+// samples, which it sees in SampleCursor::dropped. Each slot carries its own
+// sequence word (odd while being written, 2 * seq + 2 once published), so
+// readers detect a slot that was overwritten mid-copy and never return a
+// torn sample. All operations are wait-free for the producer and lock-free
+// for readers.
+class SampleRing {
+public:
+    // Capacity is rounded up to a power of two (at least 2).
+    explicit SampleRing(std::size_t capacity = 1024)
+        : mask_(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity) - 1),
+          slots_(std::make_unique<Slot[]>(mask_ + 1)) {}
+
+    SampleRing(const SampleRing&) = delete;
+    SampleRing& operator=(const SampleRing&) = delete;
+
+    std::size_t capacity() const { return mask_ + 1; }
+    // Samples pushed so far; the newest has sequence number published() - 1.
+    std::uint64_t published() const { return head_.load(std::memory_order_acquire); }
+
+    // Producer side; call from one thread only.
+    void push(const Sample& s) {
+        const std::uint64_t seq = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[seq & mask_];
+        slot.seq.store(2 * seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.stamp.store(s.stamp.time_since_epoch().count(), std::memory_order_relaxed);
+        slot.value.store(s.value, std::memory_order_relaxed);
+        slot.seq.store(2 * seq + 2, std::memory_order_release);
+        head_.store(seq + 1, std::memory_order_release);
+    }
+
+    // Newest published sample, if any.
+    std::optional<Sample> latest() const {
+        for (;;) {
+            const std::uint64_t head = published();
+            if (head == 0) return std::nullopt;
+            Sample s;
+            if (load(head - 1, s)) return s;
+            // lapped while copying: the producer is a full ring ahead, retry
+        }
+    }
+
+    // Copies up to out.size() samples from cursor.next onwards, oldest
+    // first, and advances the cursor. Returns the number copied (0 when the
+    // consumer is caught up). If the producer has overwritten samples the
+    // cursor still wanted, it skips to the oldest one left.
+    std::size_t read(SampleCursor& cursor, std::span<Sample> out) const {
+        std::uint64_t head = published();
+        std::size_t n = 0;
+        while (n < out.size() && cursor.next < head) {
+            const std::uint64_t oldest = head > capacity() ? head - capacity() : 0;
+            if (cursor.next < oldest) {
+                cursor.dropped += oldest - cursor.next;
+                cursor.next = oldest;
+            }
+            if (load(cursor.next, out[n])) {
+                ++n;
+                ++cursor.next;
+            } else {
+                // overwritten under us; the producer has moved on, so has the window
+                head = published();
+                const std::uint64_t lost = head - capacity() + 1 - cursor.next;
+                cursor.dropped += lost;
+                cursor.next += lost;
+            }
+        }
+        return n;
+    }
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> seq{0};
+        std::atomic<Timestamp::rep> stamp{0};
+        std::atomic<double> value{0.0};
+    };
+
+    bool load(std::uint64_t seq, Sample& out) const {
+        const Slot& slot = slots_[seq & mask_];
+        const std::uint64_t want = 2 * seq + 2;
+        if (slot.seq.load(std::memory_order_acquire) != want) return false;
+        const auto stamp = slot.stamp.load(std::memory_order_relaxed);
+        const double value = slot.value.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != want) return false;
+        out = {Timestamp(Timestamp::duration(stamp)), value};
+        return true;
+    }
+
+    std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<std::uint64_t> head_{0}; // own line: the only word every push and read touches
+};
+
+} // namespace robokit
@@ -0,0 +1,81 @@
+#pragma once
+#include "robokit/clock.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stop_token>
+
+namespace robokit {
+
+// What to do when a tick starts after its deadline has already passed.
+enum class OverrunPolicy {
+    Skip,    // drop the missed ticks and realign to the next period boundary
+    CatchUp  // run the missed ticks back-to-back until on schedule again
+};
+
+// Per-tick lateness (wake-up time minus scheduled deadline) and overrun counters.
+// Fixed 1us histogram so recording never allocates; readers on other threads
+// see relaxed (possibly slightly stale) values.
+class TimingStats {
+public:
+    static constexpr std::size_t kBuckets = 2048; // last bucket collects everything >= 2047us
+
+    void record(std::chrono::nanoseconds lateness);
+    void record_overrun(std::uint64_t skipped_ticks);
+    void reset();
+
+    std::uint64_t ticks() const { return ticks_.load(std::memory_order_relaxed); }
+    std::uint64_t overruns() const { return overruns_.load(std::memory_order_relaxed); }
+    std::uint64_t skipped() const { return skipped_.load(std::memory_order_relaxed); }
+    std::chrono::nanoseconds max_jitter() const;
+    std::chrono::nanoseconds mean_jitter() const;
+    // Upper bound of the bucket containing the p-th percentile (p in [0,1]).
+    std::chrono::nanoseconds percentile(double p) const;
+
+private:
+    std::atomic<std::uint64_t> ticks_{0};
+    std::atomic<std::uint64_t> overruns_{0};
+    std::atomic<std::uint64_t> skipped_{0};
+    std::atomic<std::int64_t> sum_ns_{0};
+    std::atomic<std::int64_t> max_ns_{0};
+    std::array<std::atomic<std::uint32_t>, kBuckets> hist_{};
+};
+
+// Periodic deadline scheduler sleeping on absolute time points
+// (clock_nanosleep TIMER_ABSTIME on POSIX), so wake-up error never accumulates.
+// Time comes from `time` (wall clock by default); on a VirtualClock each
+// wait_next() jumps straight to the deadline.
+class DeadlineScheduler {
+public:
+    using clock = std::chrono::steady_clock;
+
+    explicit DeadlineScheduler(clock::duration period, OverrunPolicy policy = OverrunPolicy::Skip,
+                               Clock& time = Clock::steady());
+
+    // Anchor the schedule; the first wait_next() returns at start + period.
+    void reset() { reset(time_->now()); }
+    void reset(clock::time_point start);
+    // Block until the next deadline. Returns false (without sleeping further)
+    // once stop is requested; a pending sleep still finishes its period.
+    bool wait_next(std::stop_token st = {});
+
+    clock::duration period() const { return period_; }
+    OverrunPolicy policy() const { return policy_; }
+    clock::time_point next_deadline() const { return next_; }
+    Clock& time() const { return *time_; }
+    TimingStats& stats() { return stats_; }
+    const TimingStats& stats() const { return stats_; }
+
+private:
+    clock::duration period_;
+    OverrunPolicy policy_;
+    Clock* time_;
+    clock::time_point next_;
+    TimingStats stats_;
+};
+
+// Sleep until an absolute steady_clock time point.
+void sleep_until_abs(std::chrono::steady_clock::time_point tp);
+
+} // namespace robokit
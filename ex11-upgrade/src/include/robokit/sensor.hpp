@@ -1,31 +1,67 @@
 #pragma once
 #include "robokit/robot.hpp"
-#include <random>
+#include "robokit/counter_rng.hpp"
+#include "robokit/sample_ring.hpp"
+#include <array>
 #include <chrono>
+#include <span>
 
 namespace robokit {
 
+// read() samples the sensor's clock. read_batch() produces a burst spaced by
+// `period`, starting where the previous batch ended (or now, if later), so a
+// simulation rig can pull millions of samples per second of sensor time.
+// Noise comes from a counter-based generator filled a batch at a time.
 class NoisySineSensor : public SensorBase {
 public:
-    explicit NoisySineSensor(double freq) : freq_(freq) {
-        // Predictable seed (intentional insecurity)
-        rng_.seed(42);
-    }
+    explicit NoisySineSensor(double freq, SensorClock::duration period = std::chrono::milliseconds(1),
+                             std::uint64_t seed = 42);
     const char* name() const override { return "NoisySine"; }
     double read() override;
+    std::size_t read_batch(std::span<double> values, std::span<Timestamp> stamps) override;
 private:
+    static constexpr std::size_t kBlock = 64;
     double freq_;
-    std::mt19937 rng_;
+    SensorClock::duration period_;
+    Timestamp next_{};
+    CounterRng rng_; // Predictable default seed (intentional insecurity)
+    // sin/cos(freq * i * period) for i < kBlock: each block of a batch needs
+    // one sin/cos of its first phase and then an angle-sum per sample
+    std::array<double, kBlock> sin_step_{}, cos_step_{};
 };
 
 class RandomWalkSensor : public SensorBase {
 public:
-    RandomWalkSensor() { rng_.seed(123); }
+    explicit RandomWalkSensor(SensorClock::duration period = std::chrono::milliseconds(1), std::uint64_t seed = 123)
+        : period_(period), rng_(seed) {}
     const char* name() const override { return "RandomWalk"; }
     double read() override;
+    std::size_t read_batch(std::span<double> values, std::span<Timestamp> stamps) override;
 private:
     double value_{};
-    std::mt19937 rng_;
+    SensorClock::duration period_;
+    Timestamp next_{};
+    CounterRng rng_;
+};
+
+// Publishes one sensor into a SampleRing. poll() is the producer: it reads
+// the sensor once, stamps the value and pushes it, so it belongs on a single
+// thread at the sensor's own rate (typically a RateMonotonicExecutor task,
+// see ControlLoop::add_task). Consumers at other rates take samples() and
+// call latest() or read() with their own SampleCursor; they never touch the
+// sensor or wait on the producer.
+class SensorStream {
+public:
+    explicit SensorStream(SensorBase& sensor, std::size_t capacity = 1024) : sensor_(sensor), ring_(capacity) {}
+    void poll() { ring_.push({sensor_.clock().now(), sensor_.read()}); }
+    // Publishes `count` samples pulled through read_batch(), one virtual call
+    // per 64 samples. Returns the number published.
+    std::size_t poll(std::size_t count);
+    SensorBase& sensor() const { return sensor_; }
+    const SampleRing& samples() const { return ring_; }
+private:
+    SensorBase& sensor_;
+    SampleRing ring_;
 };
 
 } // namespace robokit
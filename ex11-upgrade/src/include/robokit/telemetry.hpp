@@ -0,0 +1,178 @@
+#pragma once
+#include "robokit/clock.hpp"
+#include "robokit/robot.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// Binary telemetry: timestamped joint states and sensor values, one frame per
+// record() call, in a memory-mapped append-only file.
+//
+// Layout (native endianness, 64-byte aligned sections):
+//   header    4 KiB: magic, dof, channel count and names, block geometry,
+//             committed frame count, origin (when recording started)
+//   segment*  one index block, then blocks_per_index data blocks
+//   index     per data block: first / last stamp and frame count
+//   data      frames_per_block rows stored by column: stamps, then each
+//             joint's positions, each joint's velocities, each channel;
+//             every column is followed by 64 bytes of padding
+// Frame i therefore lives at a computed offset, a time lookup is a binary
+// search over the index blocks, and a single channel over a whole block is
+// one contiguous array.
+
+namespace robokit {
+
+namespace detail {
+struct TelemetryIndexEntry {
+    std::int64_t first_stamp, last_stamp;
+    std::uint32_t frames, reserved;
+};
+} // namespace detail
+
+struct TelemetryOptions {
+    std::size_t frames_per_block{512};  // rounded up to a multiple of 8
+    std::size_t blocks_per_index{64};
+    std::size_t reserve_frames{1 << 16}; // file space mapped up front; grows by doubling
+};
+
+// Appends frames. append() / record() only store into the mapping: no
+// allocation, no system call except when the file has to grow (once per
+// doubling). Frames must come in non-decreasing time order. The header's
+// frame count is updated with every frame, so a crashed run keeps everything
+// appended before the crash. Single-threaded; not readable while open.
+class TelemetryWriter {
+public:
+    static constexpr std::size_t kMaxChannels = 120;
+    static constexpr std::size_t kMaxNameBytes = 31;
+
+    TelemetryWriter() = default;
+    ~TelemetryWriter() { close(); }
+    TelemetryWriter(const TelemetryWriter&) = delete;
+    TelemetryWriter& operator=(const TelemetryWriter&) = delete;
+
+    // Creates (truncates) `path`. Returns false if the file cannot be created
+    // or mapped, or on more than kMaxChannels channels (names are cut to
+    // kMaxNameBytes). `origin` is the time the recorded run started.
+    bool open(const std::string& path, std::size_t dof, std::span<const std::string> channels,
+              Timestamp origin = {}, TelemetryOptions opts = {});
+    // One channel per sensor of `robot`, named after it; origin is the
+    // robot's clock now.
+    bool open(const std::string& path, const Robot& robot, TelemetryOptions opts = {});
+    // Trims the file to the frames written and unmaps it.
+    void close();
+
+    // Returns false (and writes nothing) on a size mismatch, a stamp earlier
+    // than the previous frame's, or if the file cannot grow.
+    bool append(Timestamp stamp, std::span<const double> positions, std::span<const double> velocities,
+                std::span<const double> channels);
+    // The robot's joint state plus one value per channel; call on the thread
+    // driving the robot (e.g. a simulate() task).
+    bool record(Timestamp stamp, const Robot& robot, std::span<const double> channels);
+    // A published snapshot (see Robot::state()), from any other thread.
+    bool record(const RobotState& state, std::span<const double> channels) {
+        return append(state.stamp, state.joints.positions(), state.joints.velocities(), channels);
+    }
+
+    bool is_open() const { return map_ != nullptr; }
+    std::uint64_t frames() const { return frames_; }
+    std::size_t dof() const { return dof_; }
+    std::size_t channel_count() const { return channels_; }
+
+private:
+    // Column pointer for the next row (nullptr on failure); the row's value
+    // for column c goes to p[c * frames_per_block].
+    double* begin_row(Timestamp stamp);
+    void end_row(Timestamp stamp);
+    bool map(std::size_t bytes);
+
+    int fd_{-1};
+    std::byte* map_{};
+    std::size_t mapped_{};
+    std::size_t dof_{}, channels_{};
+    std::size_t block_frames_{}, column_stride_{}, blocks_per_index_{}, block_bytes_{}, index_bytes_{}, segment_bytes_{};
+    std::uint64_t frames_{};
+    std::size_t row_{};
+    Timestamp::rep last_stamp_{};
+    Timestamp::rep* stamps_{};
+    double* columns_{};
+    detail::TelemetryIndexEntry* entry_{}; // of the current block
+};
+
+// Read-only view of a telemetry file (mapped, nothing copied).
+class TelemetryReader {
+public:
+    // A data block's columns; each span has `size()` entries.
+    struct Block {
+        std::span<const Timestamp::rep> stamps;
+        const double* base{};
+        std::size_t stride{}, dof{};
+        std::size_t size() const { return stamps.size(); }
+        std::span<const double> positions(std::size_t joint) const { return column(joint); }
+        std::span<const double> velocities(std::size_t joint) const { return column(dof + joint); }
+        std::span<const double> channel(std::size_t c) const { return column(2 * dof + c); }
+    private:
+        std::span<const double> column(std::size_t c) const { return {base + c * stride, stamps.size()}; }
+    };
+
+    TelemetryReader() = default;
+    ~TelemetryReader() { close(); }
+    TelemetryReader(const TelemetryReader&) = delete;
+    TelemetryReader& operator=(const TelemetryReader&) = delete;
+
+    // Returns false if the file is missing, not a telemetry file, or its
+    // header is inconsistent with its size. The frame count is capped by the
+    // blocks that lie wholly inside the file and the index counts, so a
+    // truncated or crashed recording opens with the frames it really holds.
+    bool open(const std::string& path);
+    void close();
+
+    bool is_open() const { return map_ != nullptr; }
+    std::uint64_t frames() const { return frames_; }
+    std::size_t dof() const { return dof_; }
+    std::size_t channel_count() const { return names_.size(); }
+    const std::string& channel_name(std::size_t c) const { return names_[c]; }
+    Timestamp origin() const { return origin_; }
+
+    Timestamp stamp(std::uint64_t frame) const;
+    double value(std::uint64_t frame, std::size_t channel) const;
+    // Copies frame `frame`: the first min(out.size(), count) joints / channels
+    // (positions and velocities; efforts and limits are not recorded).
+    void read_joints(std::uint64_t frame, JointStore& out) const;
+    void read_channels(std::uint64_t frame, std::span<double> out) const;
+    // Number of frames stamped at or before `t`.
+    std::uint64_t upper_bound(Timestamp t) const;
+
+    std::size_t block_count() const { return static_cast<std::size_t>((frames_ + block_frames_ - 1) / block_frames_); }
+    Block block(std::size_t b) const;
+
+private:
+    const std::byte* block_base(std::size_t b) const;
+    const double* row(std::uint64_t frame, std::size_t column) const;
+
+    const std::byte* map_{};
+    std::size_t mapped_{};
+    std::size_t dof_{};
+    std::vector<std::string> names_;
+    std::size_t block_frames_{}, column_stride_{}, blocks_per_index_{}, block_bytes_{}, index_bytes_{}, segment_bytes_{};
+    std::uint64_t frames_{};
+    Timestamp origin_{};
+};
+
+// Plays one recorded channel back as a sensor: read() returns the value of
+// the newest frame stamped at or before the sensor's clock (the first frame
+// before that). Meant for replay on a VirtualClock that only moves forward,
+// which makes each read amortized O(1).
+class ReplaySensor : public SensorBase {
+public:
+    ReplaySensor(const TelemetryReader& log, std::size_t channel) : log_(log), channel_(channel) {}
+    const char* name() const override { return log_.channel_name(channel_).c_str(); }
+    double read() override;
+private:
+    const TelemetryReader& log_;
+    std::size_t channel_;
+    std::uint64_t next_{0}; // frames stamped at or before the last read time
+};
+
+} // namespace robokit
@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace robokit {
+
+// Fixed pool for data-parallel loops. parallel_for() hands out [0, n) in
+// chunks of `grain` to the workers and the calling thread, and returns when
+// every chunk is done. The worker index passed to `fn` is stable within a
+// call and < size(), so callers can keep one scratch arena per index.
+class ThreadPool {
+public:
+    using ChunkFn = std::function<void(std::size_t begin, std::size_t end, std::size_t worker)>;
+
+    // `threads` counts the caller too; 0 = hardware concurrency.
+    explicit ThreadPool(std::size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t size() const { return workers_.size() + 1; }
+    // `fn` must not throw. Calls from several threads are serialized.
+    void parallel_for(std::size_t n, std::size_t grain, const ChunkFn& fn);
+
+private:
+    void run_chunks(std::size_t worker);
+    void worker_loop(std::stop_token st, std::size_t worker);
+
+    std::vector<std::jthread> workers_;
+    std::mutex submit_mtx_;
+    std::mutex mtx_;
+    std::condition_variable_any wake_cv_;
+    std::condition_variable done_cv_;
+    std::uint64_t generation_{0};
+    std::size_t pending_{0};
+
+    const ChunkFn* fn_{nullptr};
+    std::size_t n_{0}, grain_{1};
+    std::atomic<std::size_t> next_{0};
+};
+
+} // namespace robokit
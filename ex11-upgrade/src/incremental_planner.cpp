@@ -0,0 +1,121 @@
+#include "robokit/incremental_planner.hpp"
+#include <algorithm>
+
+namespace robokit {
+
+bool IncrementalPlanner::reset(int sx, int sy, int gx, int gy) {
+    if (!planner_.in_bounds(sx, sy) || !planner_.in_bounds(gx, gy)) return false;
+    w_ = planner_.width();
+    h_ = planner_.height();
+    const auto n = static_cast<std::size_t>(w_) * static_cast<std::size_t>(h_);
+    g_.assign(n, kInf);
+    rhs_.assign(n, kInf);
+    open_.clear();
+    km_ = 0;
+    start_ = last_ = sy*w_ + sx;
+    goal_ = gy*w_ + gx;
+    rhs_[goal_] = 0;
+    open_.push(key(goal_), goal_);
+    return true;
+}
+
+void IncrementalPlanner::move_start(int sx, int sy) {
+    if (!ready() || !planner_.in_bounds(sx, sy)) return;
+    start_ = sy*w_ + sx;
+    km_ += h(last_);
+    last_ = start_;
+}
+
+int IncrementalPlanner::h(int u) const {
+    return planner_.heuristic(u % w_, u / w_, start_ % w_, start_ / w_);
+}
+
+std::uint64_t IncrementalPlanner::key(int u) const {
+    const int m = std::min(g_[u], rhs_[u]);
+    const int k1 = m >= kInf ? kInf + kInf : m + h(u) + km_;
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(k1)) << 32) | static_cast<std::uint32_t>(m);
+}
+
+void IncrementalPlanner::update_vertex(int u) {
+    if (u != goal_) {
+        const int ux = u % w_, uy = u / w_;
+        int best = kInf;
+        for (int k = 0, n = planner_.step_count(); k < n; ++k) {
+            const int c = planner_.step_cost(ux, uy, k);
+            if (c == 0) continue;
+            const int s = (uy + Planner::kSteps[k].dy)*w_ + ux + Planner::kSteps[k].dx;
+            best = std::min(best, c + g_[s]);
+        }
+        // blocked cells have no usable edges
+        rhs_[u] = planner_.free_cell(ux, uy) ? std::min(best, kInf) : kInf;
+    }
+    if (g_[u] != rhs_[u]) open_.push(key(u), u);
+}
+
+void IncrementalPlanner::compute_shortest_path() {
+    while (!open_.empty()) {
+        const auto top = open_.top();
+        const int u = top.node;
+        if (g_[u] == rhs_[u]) { open_.pop(); continue; } // consistent: stale entry
+        if (top.key >= key(start_) && rhs_[start_] == g_[start_]) break;
+        open_.pop();
+        const auto k_new = key(u);
+        if (top.key < k_new) { open_.push(k_new, u); continue; }
+        if (top.key > k_new) continue; // a fresher entry is queued
+        ++stats_.expanded;
+        const int ux = u % w_, uy = u / w_;
+        if (g_[u] > rhs_[u]) {
+            g_[u] = rhs_[u];
+        } else {
+            g_[u] = kInf;
+            update_vertex(u);
+        }
+        for (int k = 0, n = planner_.step_count(); k < n; ++k) {
+            const int sx = ux + Planner::kSteps[k].dx, sy = uy + Planner::kSteps[k].dy;
+            if (planner_.in_bounds(sx, sy)) update_vertex(sy*w_ + sx);
+        }
+    }
+}
+
+void IncrementalPlanner::update_cells(std::span<const CellChange> changes) {
+    planner_.set_cells(changes);
+    if (!ready()) return;
+    // Every edge whose cost depends on a changed cell (incident edges and
+    // diagonals cutting its corner) has both endpoints in its 3x3 block.
+    for (const auto& c : changes) {
+        if (!planner_.in_bounds(c.x, c.y)) continue;
+        for (int y = std::max(0, c.y - 1); y <= std::min(h_ - 1, c.y + 1); ++y)
+            for (int x = std::max(0, c.x - 1); x <= std::min(w_ - 1, c.x + 1); ++x)
+                update_vertex(y*w_ + x);
+    }
+}
+
+std::vector<std::pair<int,int>> IncrementalPlanner::plan() {
+    stats_ = {};
+    if (!ready()) return {};
+    compute_shortest_path();
+    if (g_[start_] >= kInf || !planner_.free_cell(goal_ % w_, goal_ / w_)) return {};
+    stats_.cost = g_[start_];
+
+    // Greedy descent along c(u,s) + g(s) from the robot to the goal.
+    std::vector<std::pair<int,int>> path;
+    int u = start_;
+    path.push_back({u % w_, u / w_});
+    for (std::size_t guard = g_.size(); u != goal_ && guard > 0; --guard) {
+        const int ux = u % w_, uy = u / w_;
+        int best = kInf, next = -1;
+        for (int k = 0, n = planner_.step_count(); k < n; ++k) {
+            const int c = planner_.step_cost(ux, uy, k);
+            if (c == 0) continue;
+            const int s = (uy + Planner::kSteps[k].dy)*w_ + ux + Planner::kSteps[k].dx;
+            if (c + g_[s] < best) { best = c + g_[s]; next = s; }
+        }
+        if (next < 0) return {};
+        u = next;
+        path.push_back({u % w_, u / w_});
+    }
+    if (u != goal_) return {};
+    return path;
+}
+
+} // namespace robokit
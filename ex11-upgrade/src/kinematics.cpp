@@ -1,25 +1,239 @@
 #include "robokit/kinematics.hpp"
+#include "robokit/fixed_kinematics.hpp"
+#include "robokit/linalg.hpp"
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <numbers>
 
 namespace robokit {
 
-Pose2D Kinematics::forward(const std::vector<double>& joint_positions) {
-    double x=0.0,y=0.0,theta=0.0;
-    double acc_angle = 0.0;
-    for (double a : joint_positions) {
-        acc_angle += a;
-        x += std::cos(acc_angle); // unit length links
-        y += std::sin(acc_angle);
+namespace {
+
+// Runtime-DOF entry points call fn(integral_constant<N>) for the
+// FixedKinematics<N> fast path, or fn(integral_constant<0>) for the generic loop.
+template <typename F>
+decltype(auto) dispatch_dof(std::size_t dof, F&& fn) {
+    static_assert(kMaxFixedDof == 7, "extend the switch below");
+    switch (dof) {
+    case 2: return fn(std::integral_constant<std::size_t, 2>{});
+    case 3: return fn(std::integral_constant<std::size_t, 3>{});
+    case 4: return fn(std::integral_constant<std::size_t, 4>{});
+    case 5: return fn(std::integral_constant<std::size_t, 5>{});
+    case 6: return fn(std::integral_constant<std::size_t, 6>{});
+    case 7: return fn(std::integral_constant<std::size_t, 7>{});
+    default: return fn(std::integral_constant<std::size_t, 0>{});
     }
-    if (!joint_positions.empty()) theta = acc_angle;
-    return {x,y,theta};
 }
 
-std::optional<std::vector<double>> Kinematics::inverse(const Pose2D& target, std::size_t dof) {
-    // Extremely naive: evenly distribute angle, ignore position (not a real IK solution).
-    if (dof == 0) return std::nullopt;
-    std::vector<double> joints(dof, target.theta / static_cast<double>(dof));
-    return joints;
+} // namespace
+
+Pose2D Kinematics::forward(std::span<const double> joint_positions) {
+    return dispatch_dof(joint_positions.size(), [&](auto n) -> Pose2D {
+        constexpr std::size_t N = decltype(n)::value;
+        if constexpr (N > 0) {
+            return FixedKinematics<N>::forward(std::span<const double, N>(joint_positions.data(), N));
+        } else {
+            double x=0.0,y=0.0,theta=0.0;
+            double acc_angle = 0.0;
+            for (double a : joint_positions) {
+                acc_angle += a;
+                x += std::cos(acc_angle); // unit length links
+                y += std::sin(acc_angle);
+            }
+            if (!joint_positions.empty()) theta = acc_angle;
+            return {x,y,theta};
+        }
+    });
+}
+
+FkCache::FkCache(std::size_t dof) : q_(dof, 0.0), links_(dof) {}
+
+void FkCache::set_joint(std::size_t j, double value) {
+    if (j >= q_.size() || q_[j] == value) return;
+    q_[j] = value;
+    dirty_ = std::min(dirty_, j);
+}
+
+void FkCache::set_joints(std::span<const double> q) {
+    const std::size_t n = std::min(q.size(), q_.size());
+    for (std::size_t j = 0; j < n; ++j) set_joint(j, q[j]);
+}
+
+void FkCache::update() {
+    for (std::size_t i = dirty_; i < q_.size(); ++i) {
+        const Link prev = i > 0 ? links_[i - 1] : Link{0.0, 1.0, 0.0, 0.0, 0.0};
+        Link& l = links_[i];
+        l.phi = prev.phi + q_[i];
+        l.c = std::cos(l.phi);
+        l.s = std::sin(l.phi);
+        l.x = prev.x + l.c; // unit length links
+        l.y = prev.y + l.s;
+        ++links_updated_;
+    }
+    dirty_ = q_.size();
+}
+
+Pose2D FkCache::pose() {
+    if (q_.empty()) return {};
+    return link(q_.size() - 1);
+}
+
+Pose2D FkCache::link(std::size_t i) {
+    update();
+    const Link& l = links_[i];
+    return {l.x, l.y, l.phi};
+}
+
+std::optional<std::array<double, 2>> Kinematics::inverse_2r(const Pose2D& target, Elbow elbow) {
+    // |p|^2 = 2 + 2 cos q2 for two unit links
+    const double d2 = target.x * target.x + target.y * target.y;
+    const double c2 = 0.5 * d2 - 1.0;
+    if (!(c2 <= 1.0)) return std::nullopt; // beyond reach (or NaN)
+    const double s2 = std::sqrt(std::max(0.0, 1.0 - c2 * c2)) * (elbow == Elbow::Up ? -1.0 : 1.0);
+    const double q2 = std::atan2(s2, c2);
+    // q1 = atan2(y, x) - atan2(s2, 1 + c2), folded into one atan2 of the rotated target
+    const double q1 = std::atan2(target.y * (1.0 + c2) - target.x * s2, target.x * (1.0 + c2) + target.y * s2);
+    return std::array<double, 2>{q1, q2};
+}
+
+std::optional<std::array<double, 3>> Kinematics::inverse_3r(const Pose2D& target, Elbow elbow) {
+    const Pose2D wrist{target.x - std::cos(target.theta), target.y - std::sin(target.theta), 0.0};
+    const auto q = inverse_2r(wrist, elbow);
+    if (!q) return std::nullopt;
+    double q3 = target.theta - (*q)[0] - (*q)[1];
+    if (std::fabs(q3) > std::numbers::pi) q3 = std::remainder(q3, 2.0 * std::numbers::pi); // rarely taken
+    return std::array<double, 3>{(*q)[0], (*q)[1], q3};
+}
+
+std::optional<std::vector<double>> Kinematics::inverse(const Pose2D& target, std::size_t dof, Elbow elbow) {
+    if (dof == 2) {
+        const auto q = inverse_2r(target, elbow);
+        if (!q) return std::nullopt;
+        return std::vector<double>(q->begin(), q->end());
+    }
+    if (dof == 3) {
+        const auto q = inverse_3r(target, elbow);
+        if (!q) return std::nullopt;
+        return std::vector<double>(q->begin(), q->end());
+    }
+    if (dof == 0 || dof > IkSolver::kMaxDof) return std::nullopt;
+    IkSolver solver(dof);
+    if (!solver.solve(target).converged) return std::nullopt;
+    const auto q = solver.joints();
+    return std::vector<double>(q.begin(), q.end());
+}
+
+IkSolver::IkSolver(std::size_t dof, IkOptions opts)
+    : dof_(std::clamp<std::size_t>(dof, 1, kMaxDof)), opts_(opts) {
+    lower_.fill(-std::numeric_limits<double>::infinity());
+    upper_.fill(std::numeric_limits<double>::infinity());
+}
+
+void IkSolver::seed(std::span<const double> joints) {
+    for (std::size_t j = 0; j < dof_; ++j) q_[j] = j < joints.size() ? joints[j] : 0.0;
+    clamp(q_);
+}
+
+void IkSolver::set_limits(std::span<const double> lower, std::span<const double> upper) {
+    for (std::size_t j = 0; j < dof_; ++j) {
+        lower_[j] = j < lower.size() ? lower[j] : -std::numeric_limits<double>::infinity();
+        upper_[j] = j < upper.size() ? upper[j] : std::numeric_limits<double>::infinity();
+    }
+    clamp(q_);
+}
+
+void IkSolver::clamp(Vec& q) const {
+    for (std::size_t j = 0; j < dof_; ++j) q[j] = std::min(std::max(q[j], lower_[j]), upper_[j]);
+}
+
+template <std::size_t N>
+double IkSolver::pose_error(const Vec& q, const Pose2D& target, linalg::Vec3d& e, Vec& c, Vec& s) const {
+    double x = 0.0, y = 0.0, phi = 0.0;
+    if constexpr (N > 0) {
+        const Pose2D p = FixedKinematics<N>::forward(std::span<const double, N>(q.data(), N),
+                                                     std::span<double, N>(c.data(), N),
+                                                     std::span<double, N>(s.data(), N));
+        x = p.x;
+        y = p.y;
+        phi = p.theta;
+    } else {
+        for (std::size_t j = 0; j < dof_; ++j) {
+            phi += q[j];
+            c[j] = std::cos(phi);
+            s[j] = std::sin(phi);
+            x += c[j];
+            y += s[j];
+        }
+    }
+    e[0] = target.x - x;
+    e[1] = target.y - y;
+    // shortest signed angle, so a full turn is no error
+    e[2] = opts_.orientation_weight * std::remainder(target.theta - phi, 2.0 * std::numbers::pi);
+    return linalg::norm(e);
+}
+
+IkResult IkSolver::solve(const Pose2D& target) {
+    return dispatch_dof(dof_, [&](auto n) { return solve_n<decltype(n)::value>(target); });
+}
+
+template <std::size_t N>
+IkResult IkSolver::solve_n(const Pose2D& target) {
+    // fixed-DOF instances size the Jacobian exactly; the generic one pads to kMaxDof
+    constexpr std::size_t kCols = N > 0 ? N : kMaxDof;
+    const std::size_t dof = N > 0 ? N : dof_;
+    linalg::Vec3d e, e_try;
+    Vec c{}, s{}, c_try{}, s_try{}, q_try{};
+    double err = pose_error<N>(q_, target, e, c, s);
+    double lambda = opts_.damping;
+    IkResult r;
+
+    while (err > opts_.tolerance && r.iterations < opts_.max_iterations) {
+        ++r.iterations;
+        // Jacobian rows: dx/dq_j = -sum_{i>=j} sin(phi_i), dy/dq_j = sum_{i>=j} cos(phi_i),
+        // dtheta/dq_j = 1 (scaled by the orientation weight), built as suffix sums.
+        linalg::Mat<double, 3, kCols> J;
+        if constexpr (N > 0) {
+            FixedKinematics<N>::jacobian(std::span<const double, N>(c.data(), N),
+                                         std::span<const double, N>(s.data(), N), J.row(0), J.row(1));
+        } else {
+            double sx = 0.0, sy = 0.0;
+            for (std::size_t j = dof; j-- > 0;) {
+                sx += s[j];
+                sy += c[j];
+                J(0, j) = -sx;
+                J(1, j) = sy;
+            }
+        }
+        for (std::size_t j = 0; j < dof; ++j) J(2, j) = opts_.orientation_weight;
+
+        // (J J^T + lambda^2 I) u = e, dq = J^T u; the matrix is SPD whenever lambda > 0
+        linalg::Mat3d A = linalg::mul_transposed(J, dof);
+        for (std::size_t i = 0; i < 3; ++i) A(i, i) += lambda * lambda;
+        linalg::Vec3d u;
+        if (!linalg::solve(A, e, u)) {
+            lambda = std::max(lambda * 10.0, 1e-6);
+            continue;
+        }
+        const auto dq = linalg::transpose_mul(J, u);
+        for (std::size_t j = 0; j < dof; ++j) q_try[j] = q_[j] + dq[j];
+        clamp(q_try);
+        const double err_try = pose_error<N>(q_try, target, e_try, c_try, s_try);
+        if (err_try < err) {
+            q_ = q_try;
+            e = e_try;
+            c = c_try;
+            s = s_try;
+            err = err_try;
+            lambda = std::max(lambda * 0.5, opts_.damping);
+        } else {
+            // overshoot or blocked by a limit: damp harder and retry from q_
+            lambda = std::max(lambda * 10.0, 1e-6);
+        }
+    }
+    r.converged = err <= opts_.tolerance;
+    r.error = err;
+    return r;
 }
 
 } // namespace robokit
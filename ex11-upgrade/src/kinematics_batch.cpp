@@ -0,0 +1,228 @@
+#include "robokit/kinematics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define ROBOKIT_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// Batched forward kinematics. A SIMD register holds the running angle of 4
+// (AVX2) or 8 (AVX-512) configurations; each joint adds one row of the SoA
+// batch and one vectorized sincos yields the link's x/y step for all lanes.
+// Kernels carry per-function target attributes and are picked at runtime,
+// so the library itself is built without -mavx flags. Leftover
+// configurations, and lanes whose angle leaves the exact reduction range,
+// go through std::cos / std::sin exactly like forward().
+
+namespace robokit {
+
+namespace {
+
+// Scalar path, joint-major so every access is a contiguous row. Summation
+// order matches forward(), so results are bit-identical to it.
+void forward_scalar(const double* a, std::size_t dof, std::size_t stride, std::size_t begin, std::size_t end,
+                    double* ox, double* oy, double* ot) {
+    std::fill(ox + begin, ox + end, 0.0);
+    std::fill(oy + begin, oy + end, 0.0);
+    std::fill(ot + begin, ot + end, 0.0);
+    for (std::size_t j = 0; j < dof; ++j) {
+        const double* row = a + j * stride;
+        for (std::size_t i = begin; i < end; ++i) {
+            ot[i] += row[i];
+            ox[i] += std::cos(ot[i]);
+            oy[i] += std::sin(ot[i]);
+        }
+    }
+}
+
+#ifdef ROBOKIT_X86_SIMD
+
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC's AVX-512 headers seed masked builtins with _mm512_undefined_*(),
+// which -Wmaybe-uninitialized misreports once inlined here
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// x = k * pi/2 + r with |r| <= pi/4. pi/2 is split Cody-Waite style (fdlibm
+// pio2_1/2/3); the first two parts have 33 significant bits, so k * part is
+// exact while |k| < 2^20, which kReduceLimit keeps with margin.
+constexpr double kTwoOverPi = 6.36619772367581382433e-01;
+constexpr double kPio2_1 = 1.57079632673412561417e+00;
+constexpr double kPio2_2 = 6.07710050630396597660e-11;
+constexpr double kPio2_3 = 2.02226624871116645580e-21;
+constexpr double kReduceLimit = 8.0e5;
+
+// Cephes minimax polynomials on [-pi/4, pi/4]:
+// sin r = r + r z S(z), cos r = 1 - z/2 + z^2 C(z), z = r^2.
+constexpr double kSin[6] = {
+    1.58962301576546568060e-10, -2.50507477628578072866e-8, 2.75573136213857245213e-6,
+    -1.98412698295895385996e-4, 8.33333333332211858878e-3, -1.66666666666666307295e-1,
+};
+constexpr double kCos[6] = {
+    -1.13585365213876817300e-11, 2.08757008419747316778e-9, -2.75573141792967388112e-7,
+    2.48015872888517045348e-5, -1.38888888888730564116e-3, 4.16666666666665929218e-2,
+};
+
+// Quadrant q = k mod 4 maps (sin r, cos r) to (sin x, cos x):
+// q=0 (s, c), q=1 (c, -s), q=2 (-s, -c), q=3 (-c, s).
+
+__attribute__((target("avx2,fma")))
+inline void sincos_avx2(__m256d x, __m256d& s, __m256d& c) {
+    const __m256d k = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(kTwoOverPi)),
+                                      _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(kPio2_1), x);
+    r = _mm256_fnmadd_pd(k, _mm256_set1_pd(kPio2_2), r);
+    r = _mm256_fnmadd_pd(k, _mm256_set1_pd(kPio2_3), r);
+    const __m256d z = _mm256_mul_pd(r, r);
+
+    __m256d ps = _mm256_set1_pd(kSin[0]);
+    __m256d pc = _mm256_set1_pd(kCos[0]);
+    for (int i = 1; i < 6; ++i) {
+        ps = _mm256_fmadd_pd(ps, z, _mm256_set1_pd(kSin[i]));
+        pc = _mm256_fmadd_pd(pc, z, _mm256_set1_pd(kCos[i]));
+    }
+    const __m256d sr = _mm256_fmadd_pd(_mm256_mul_pd(r, z), ps, r);
+    const __m256d cr = _mm256_fmadd_pd(_mm256_mul_pd(z, z), pc,
+                                       _mm256_fnmadd_pd(_mm256_set1_pd(0.5), z, _mm256_set1_pd(1.0)));
+
+    const __m256i q = _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(k));
+    const __m256i one = _mm256_set1_epi64x(1), two = _mm256_set1_epi64x(2);
+    const __m256d swap = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(q, one), one));
+    const __m256d sin_sign = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(q, two), 62));
+    const __m256d cos_sign =
+        _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(_mm256_add_epi64(q, one), two), 62));
+    s = _mm256_xor_pd(_mm256_blendv_pd(sr, cr, swap), sin_sign);
+    c = _mm256_xor_pd(_mm256_blendv_pd(cr, sr, swap), cos_sign);
+}
+
+// Returns how many leading configurations were written (a multiple of 4).
+__attribute__((target("avx2,fma")))
+std::size_t forward_avx2(const double* a, std::size_t dof, std::size_t stride, std::size_t count,
+                         double* ox, double* oy, double* ot) {
+    const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFF));
+    const __m256d limit = _mm256_set1_pd(kReduceLimit);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d acc = _mm256_setzero_pd(), x = acc, y = acc, out_of_range = acc;
+        for (std::size_t j = 0; j < dof; ++j) {
+            acc = _mm256_add_pd(acc, _mm256_loadu_pd(a + j * stride + i));
+            // NaN compares "not <=" as well, so it takes the scalar path too
+            out_of_range = _mm256_or_pd(out_of_range,
+                                        _mm256_cmp_pd(_mm256_and_pd(acc, abs_mask), limit, _CMP_NLE_UQ));
+            __m256d s, c;
+            sincos_avx2(acc, s, c);
+            x = _mm256_add_pd(x, c);
+            y = _mm256_add_pd(y, s);
+        }
+        _mm256_storeu_pd(ox + i, x);
+        _mm256_storeu_pd(oy + i, y);
+        _mm256_storeu_pd(ot + i, acc);
+        if (_mm256_movemask_pd(out_of_range)) forward_scalar(a, dof, stride, i, i + 4, ox, oy, ot);
+    }
+    return i;
+}
+
+__attribute__((target("avx512f")))
+inline void sincos_avx512(__m512d x, __m512d& s, __m512d& c) {
+    const __m512d k = _mm512_roundscale_pd(_mm512_mul_pd(x, _mm512_set1_pd(kTwoOverPi)),
+                                           _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512d r = _mm512_fnmadd_pd(k, _mm512_set1_pd(kPio2_1), x);
+    r = _mm512_fnmadd_pd(k, _mm512_set1_pd(kPio2_2), r);
+    r = _mm512_fnmadd_pd(k, _mm512_set1_pd(kPio2_3), r);
+    const __m512d z = _mm512_mul_pd(r, r);
+
+    __m512d ps = _mm512_set1_pd(kSin[0]);
+    __m512d pc = _mm512_set1_pd(kCos[0]);
+    for (int i = 1; i < 6; ++i) {
+        ps = _mm512_fmadd_pd(ps, z, _mm512_set1_pd(kSin[i]));
+        pc = _mm512_fmadd_pd(pc, z, _mm512_set1_pd(kCos[i]));
+    }
+    const __m512d sr = _mm512_fmadd_pd(_mm512_mul_pd(r, z), ps, r);
+    const __m512d cr = _mm512_fmadd_pd(_mm512_mul_pd(z, z), pc,
+                                       _mm512_fnmadd_pd(_mm512_set1_pd(0.5), z, _mm512_set1_pd(1.0)));
+
+    const __m512i q = _mm512_cvtepi32_epi64(_mm512_cvtpd_epi32(k));
+    const __m512i one = _mm512_set1_epi64(1), two = _mm512_set1_epi64(2);
+    const __mmask8 swap = _mm512_test_epi64_mask(q, one);
+    const __m512i sin_sign = _mm512_slli_epi64(_mm512_and_si512(q, two), 62);
+    const __m512i cos_sign = _mm512_slli_epi64(_mm512_and_si512(_mm512_add_epi64(q, one), two), 62);
+    // AVX512F has no xor_pd (that is DQ), so flip signs in the integer domain
+    s = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(_mm512_mask_blend_pd(swap, sr, cr)), sin_sign));
+    c = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(_mm512_mask_blend_pd(swap, cr, sr)), cos_sign));
+}
+
+// Returns how many leading configurations were written (a multiple of 8).
+__attribute__((target("avx512f")))
+std::size_t forward_avx512(const double* a, std::size_t dof, std::size_t stride, std::size_t count,
+                           double* ox, double* oy, double* ot) {
+    const __m512d limit = _mm512_set1_pd(kReduceLimit);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512d acc = _mm512_setzero_pd(), x = acc, y = acc;
+        __mmask8 out_of_range = 0;
+        for (std::size_t j = 0; j < dof; ++j) {
+            acc = _mm512_add_pd(acc, _mm512_loadu_pd(a + j * stride + i));
+            out_of_range |= _mm512_cmp_pd_mask(_mm512_abs_pd(acc), limit, _CMP_NLE_UQ);
+            __m512d s, c;
+            sincos_avx512(acc, s, c);
+            x = _mm512_add_pd(x, c);
+            y = _mm512_add_pd(y, s);
+        }
+        _mm512_storeu_pd(ox + i, x);
+        _mm512_storeu_pd(oy + i, y);
+        _mm512_storeu_pd(ot + i, acc);
+        if (out_of_range) forward_scalar(a, dof, stride, i, i + 8, ox, oy, ot);
+    }
+    return i;
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+SimdLevel detect_simd() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdLevel::AVX2;
+    return SimdLevel::Scalar;
+}
+
+#else
+
+SimdLevel detect_simd() { return SimdLevel::Scalar; }
+
+#endif
+
+} // namespace
+
+SimdLevel Kinematics::simd_level() {
+    static const SimdLevel level = detect_simd();
+    return level;
+}
+
+bool Kinematics::forward_batch(const JointBatch& joints, const PoseBatch& out, SimdLevel max_level) {
+    const std::size_t n = joints.count;
+    const std::size_t stride = joints.stride ? joints.stride : n;
+    if (stride < n || out.x.size() < n || out.y.size() < n || out.theta.size() < n) return false;
+    if (joints.dof > 0 && n > 0 && joints.angles.size() < (joints.dof - 1) * stride + n) return false;
+
+    const double* a = joints.angles.data();
+    double* ox = out.x.data();
+    double* oy = out.y.data();
+    double* ot = out.theta.data();
+    std::size_t done = 0;
+#ifdef ROBOKIT_X86_SIMD
+    const SimdLevel level = std::min(max_level, simd_level());
+    if (level == SimdLevel::AVX512) done = forward_avx512(a, joints.dof, stride, n, ox, oy, ot);
+    else if (level == SimdLevel::AVX2) done = forward_avx2(a, joints.dof, stride, n, ox, oy, ot);
+#else
+    (void)max_level;
+#endif
+    forward_scalar(a, joints.dof, stride, done, n, ox, oy, ot);
+    return true;
+}
+
+} // namespace robokit
@@ -1,2 +1,130 @@
 #include "robokit/logging.hpp"
-// Intentionally left mostly inline. This TU can later host advanced logger impl.
+#include <atomic>
+#include <charconv>
+#include <iostream>
+#include <mutex>
+
+namespace robokit::log {
+
+namespace {
+
+// Sites live in a fixed table so lookups from sinks need no lock: writers
+// fill a slot under the mutex, then publish it by bumping the count.
+constexpr std::size_t kMaxSites = 4096;
+std::array<Site, kMaxSites> g_sites;
+std::atomic<std::size_t> g_site_count{0};
+std::mutex g_intern_mutex;
+
+std::atomic<Sink> g_sink{print_sink};
+std::atomic<void*> g_sink_context{nullptr};
+
+std::mutex g_print_mutex; // global state (intentional)
+
+const char* prefix(Level l) {
+    switch (l) {
+    case Level::Debug: return "[DBG ] ";
+    case Level::Info: return "[INFO] ";
+    case Level::Warn: return "[WARN] ";
+    default: return "[ERR ] ";
+    }
+}
+
+void print_line(Level level, std::string_view msg) {
+    std::lock_guard<std::mutex> lk(g_print_mutex);
+    (level == Level::Error ? std::cerr : std::cout) << prefix(level) << msg << '\n';
+}
+
+template <Level L>
+void legacy(std::string_view msg) {
+    if constexpr (enabled(L)) {
+        static const FormatId id = intern(L, "{}", __FILE__, __LINE__);
+        if (msg.size() > Record::kTextBytes && g_sink.load(std::memory_order_acquire) == print_sink) {
+            print_line(L, msg); // would not fit a Record; print it whole as before
+            return;
+        }
+        emit(L, id, "{}", msg);
+    }
+}
+
+void append(std::string& out, const Record& r, std::size_t k) {
+    const auto& v = r.args[k];
+    char buf[32];
+    std::to_chars_result res{buf, {}};
+    switch (r.types[k]) {
+    case ArgType::Bool: out += v.b ? "true" : "false"; return;
+    case ArgType::Char: out += v.c; return;
+    case ArgType::String:
+        out.append(r.text.data() + v.s.offset, v.s.size);
+        if (v.s.size < v.s.length) out += "..."; // cut to fit the record
+        return;
+    case ArgType::Int: res = std::to_chars(buf, buf + sizeof buf, v.i); break;
+    case ArgType::UInt: res = std::to_chars(buf, buf + sizeof buf, v.u); break;
+    case ArgType::Double: res = std::to_chars(buf, buf + sizeof buf, v.d); break;
+    case ArgType::Pointer:
+        out += "0x";
+        res = std::to_chars(buf, buf + sizeof buf, reinterpret_cast<std::uintptr_t>(v.p), 16);
+        break;
+    }
+    out.append(buf, res.ptr);
+}
+
+} // namespace
+
+FormatId intern(Level level, const char* format, const char* file, int line) {
+    std::lock_guard<std::mutex> lk(g_intern_mutex);
+    const std::size_t n = g_site_count.load(std::memory_order_relaxed);
+    if (n == kMaxSites) return kMaxSites - 1; // table full: share the last slot rather than fail a log call
+    g_sites[n] = {format, file, line, level};
+    g_site_count.store(n + 1, std::memory_order_release);
+    return static_cast<FormatId>(n);
+}
+
+const Site& site(FormatId id) { return g_sites[id]; }
+
+std::size_t site_count() { return g_site_count.load(std::memory_order_acquire); }
+
+std::string format(const Record& r) {
+    std::string out;
+    std::size_t arg = 0;
+    for (const char* f = site(r.id).format; *f; ++f) {
+        if ((f[0] == '{' && f[1] == '{') || (f[0] == '}' && f[1] == '}')) {
+            out += *f++;
+        } else if (f[0] == '{' && f[1] == '}') {
+            if (arg < r.arg_count) append(out, r, arg++);
+            ++f;
+        } else {
+            out += *f;
+        }
+    }
+    return out;
+}
+
+void set_sink(Sink sink, void* context) {
+    g_sink_context.store(context, std::memory_order_relaxed);
+    g_sink.store(sink ? sink : print_sink, std::memory_order_release);
+}
+
+void print_sink(const Record& r, void*) { print_line(r.level, format(r)); }
+
+void print_batch_sink(std::span<const Record> records, void*) {
+    std::string out, err;
+    for (const Record& r : records) {
+        std::string& s = r.level == Level::Error ? err : out;
+        s += prefix(r.level);
+        s += format(r);
+        s += '\n';
+    }
+    std::lock_guard<std::mutex> lk(g_print_mutex);
+    if (!out.empty()) std::cout << out;
+    if (!err.empty()) std::cerr << err;
+}
+
+void detail::dispatch(const Record& r) {
+    g_sink.load(std::memory_order_acquire)(r, g_sink_context.load(std::memory_order_relaxed));
+}
+
+void info(std::string_view msg) { legacy<Level::Info>(msg); }
+void warn(std::string_view msg) { legacy<Level::Warn>(msg); }
+void error(std::string_view msg) { legacy<Level::Error>(msg); }
+
+} // namespace robokit::log
@@ -2,23 +2,37 @@
 #include "robokit/sensor.hpp"
 #include "robokit/planner.hpp"
 #include "robokit/control_loop.hpp"
-#include "robokit/logging.hpp"
+#include "robokit/async_logger.hpp"
+#include <chrono>
 #include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
 
 using namespace robokit;
 
 int main() {
+    log::AsyncLogger logger; // the control thread's log calls only queue records
     Robot robot("demo_bot", 3);
     robot.add_sensor(new NoisySineSensor(1.0));
     robot.add_sensor(new RandomWalkSensor());
     Planner planner(10,10);
     ControlLoop loop(robot, planner);
+    // each sensor publishes on its own executor task; the loop below only reads rings
+    std::vector<std::unique_ptr<SensorStream>> streams;
+    for (auto* s : robot.sensors()) {
+        streams.push_back(std::make_unique<SensorStream>(*s));
+        loop.add_task(s->name(), std::chrono::milliseconds(1), [st = streams.back().get()] { st->poll(); });
+    }
     loop.start();
+    RobotState state; // the loop publishes a snapshot per tick; read it instead of robot.joints()
     for (int i=0;i<5;++i) {
-        // naive sensor poll
-        for (auto* s : robot.sensors()) {
-            double v = s->read();
-            std::cout << s->name() << ": " << v << '\n';
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        if (robot.state().read(state))
+            std::cout << "tick " << state.sequence << ": q0 = " << state.joints.positions()[0] << "\n";
+        for (const auto& st : streams) {
+            if (auto sample = st->samples().latest())
+                std::cout << st->sensor().name() << ": " << sample->value << " (" << st->samples().published() << " samples)\n";
         }
     }
     loop.stop();
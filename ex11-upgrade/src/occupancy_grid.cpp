@@ -0,0 +1,65 @@
+#include "robokit/occupancy_grid.hpp"
+
+namespace robokit {
+
+OccupancyGrid::OccupancyGrid(int w, int h)
+    : w_(w), h_(h), tiles_x_((w + kTile - 1) / kTile), tiles_y_((h + kTile - 1) / kTile),
+      tiles_(static_cast<std::size_t>(tiles_x_) * tiles_y_, 0) {
+    // Padding cells in the last tile row/column read as blocked so the
+    // single-word neighbour path needs no extra bounds checks.
+    for (int ty = 0; ty < tiles_y_; ++ty) {
+        for (int tx = 0; tx < tiles_x_; ++tx) {
+            std::uint64_t pad = 0;
+            for (int ly = 0; ly < kTile; ++ly)
+                for (int lx = 0; lx < kTile; ++lx)
+                    if (tx*kTile + lx >= w_ || ty*kTile + ly >= h_) pad |= std::uint64_t{1} << (ly*kTile + lx);
+            tiles_[static_cast<std::size_t>(ty) * tiles_x_ + tx] = pad;
+        }
+    }
+}
+
+OccupancyGrid OccupancyGrid::from_bytes(int w, int h, const std::vector<std::uint8_t>& bytes) {
+    OccupancyGrid g(w, h);
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+            if (bytes[static_cast<std::size_t>(y) * w + x] != 0) g.set(x, y, true);
+    return g;
+}
+
+void OccupancyGrid::to_bytes(std::vector<std::uint8_t>& out) const {
+    out.assign(static_cast<std::size_t>(w_) * h_, 0);
+    for (int y = 0; y < h_; ++y)
+        for (int x = 0; x < w_; ++x)
+            out[static_cast<std::size_t>(y) * w_ + x] = blocked(x, y) ? 1 : 0;
+}
+
+void OccupancyGrid::set(int x, int y, bool blocked) {
+    if (!in_bounds(x, y)) return;
+    const auto bit = std::uint64_t{1} << bit_index(x, y);
+    auto& word = tiles_[tile_index(x, y)];
+    word = blocked ? (word | bit) : (word & ~bit);
+}
+
+std::uint8_t OccupancyGrid::blocked_neighbors(int x, int y) const {
+    const int lx = x % kTile, ly = y % kTile;
+    std::uint64_t r0, r1, r2; // 3-bit rows y-1, y, y+1 covering x-1..x+1
+    if (x >= 0 && y >= 0 && lx >= 1 && lx <= kTile - 2 && ly >= 1 && ly <= kTile - 2) {
+        const std::uint64_t word = tiles_[tile_index(x, y)];
+        const int base = (ly - 1) * kTile + (lx - 1);
+        r0 = (word >> base) & 7u;
+        r1 = (word >> (base + kTile)) & 7u;
+        r2 = (word >> (base + 2*kTile)) & 7u;
+    } else {
+        auto row = [&](int yy) {
+            return std::uint64_t{blocked(x-1, yy)} | std::uint64_t{blocked(x, yy)} << 1 | std::uint64_t{blocked(x+1, yy)} << 2;
+        };
+        r0 = row(y - 1);
+        r1 = row(y);
+        r2 = row(y + 1);
+    }
+    return static_cast<std::uint8_t>(
+        ((r1 >> 2) & 1) | (r1 & 1) << 1 | ((r2 >> 1) & 1) << 2 | ((r0 >> 1) & 1) << 3 |
+        ((r2 >> 2) & 1) << 4 | ((r0 >> 2) & 1) << 5 | (r2 & 1) << 6 | (r0 & 1) << 7);
+}
+
+} // namespace robokit
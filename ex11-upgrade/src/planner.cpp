@@ -1,11 +1,151 @@
 #include "robokit/planner.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
 #include <queue>
 
 namespace robokit {
 
-Planner::Planner(int w, int h) : w_(w), h_(h), grid_(w*h, 0) {}
+namespace {
+
+static_assert(Planner::kSteps[0].dx == 1 && Planner::kSteps[3].dy == -1 &&
+              Planner::kSteps[4].dx == 1 && Planner::kSteps[4].dy == 1 &&
+              Planner::kSteps[7].dx == -1 && Planner::kSteps[7].dy == -1,
+              "kSteps must follow OccupancyGrid::blocked_neighbors bit order");
+
+// Occupancy accessors for the shared A* core.
+struct ByteCells {
+    const uint8_t* g;
+    int w, h, n_steps;
+    std::uint8_t blocked_neighbors(int x, int y) const {
+        unsigned m = 0;
+        for (int k = 0; k < n_steps; ++k) {
+            const int nx = x + Planner::kSteps[k].dx, ny = y + Planner::kSteps[k].dy;
+            if (nx < 0 || nx >= w || ny < 0 || ny >= h || g[ny*w + nx] != 0) m |= 1u << k;
+        }
+        return static_cast<std::uint8_t>(m);
+    }
+};
+
+struct PackedCells {
+    const OccupancyGrid& g;
+    std::uint8_t blocked_neighbors(int x, int y) const { return g.blocked_neighbors(x, y); }
+};
+
+struct StampVisited {
+    std::uint32_t* seen;
+    std::uint32_t* closed;
+    std::uint32_t sid;
+    bool is_seen(int i) const { return seen[i] == sid; }
+    void mark_seen(int i) { seen[i] = sid; }
+    bool is_closed(int i) const { return closed[i] == sid; }
+    void mark_closed(int i) { closed[i] = sid; }
+};
+
+// Search goals for best_first(): one cell with an admissible heuristic, or a
+// set of cells settled by plain Dijkstra.
+struct SingleTarget {
+    const Planner& planner;
+    int goal, gx, gy;
+    int h(int x, int y) const { return planner.heuristic(x, y, gx, gy); }
+    bool reached(int cell) const { return cell == goal; }
+};
+
+struct SettleTargets {
+    std::span<const int> targets; // sorted, unique
+    std::size_t remaining;
+    int h(int, int) const { return 0; }
+    bool reached(int cell) {
+        return std::binary_search(targets.begin(), targets.end(), cell) && --remaining == 0;
+    }
+};
+
+struct BitVisited {
+    BitSet& seen;
+    BitSet& closed;
+    bool is_seen(int i) const { return seen.test(static_cast<std::size_t>(i)); }
+    void mark_seen(int i) { seen.set(static_cast<std::size_t>(i)); }
+    bool is_closed(int i) const { return closed.test(static_cast<std::size_t>(i)); }
+    void mark_closed(int i) { closed.set(static_cast<std::size_t>(i)); }
+};
+
+} // namespace
+
+Planner::Planner(int w, int h, PlannerOptions opts) : w_(w), h_(h), opts_(opts) {
+    if (packed()) cells_ = OccupancyGrid(w, h);
+    else grid_.assign(static_cast<std::size_t>(w) * h, 0);
+}
+
+void Planner::set_options(const PlannerOptions& opts) {
+    const bool was_packed = packed();
+    if (opts.connectivity != opts_.connectivity) flow_stale_ = true;
+    opts_ = opts;
+    if (was_packed == packed()) return;
+    if (packed()) {
+        cells_ = OccupancyGrid::from_bytes(w_, h_, grid_);
+        std::vector<uint8_t>().swap(grid_);
+    } else {
+        if (!bytes_dirty_) cells_.to_bytes(grid_);
+        cells_ = OccupancyGrid();
+    }
+    bytes_dirty_ = false;
+    caches_stale_ = true;
+}
+
+std::vector<uint8_t>& Planner::grid() {
+    if (packed() && grid_.empty()) cells_.to_bytes(grid_);
+    invalidate();
+    return grid_;
+}
+
+std::vector<uint8_t> Planner::grid() const {
+    if (!packed() || bytes_dirty_) return grid_;
+    std::vector<uint8_t> bytes;
+    cells_.to_bytes(bytes);
+    return bytes;
+}
+
+void Planner::sync_storage() {
+    if (!bytes_dirty_) return;
+    cells_ = OccupancyGrid::from_bytes(w_, h_, grid_);
+    std::vector<uint8_t>().swap(grid_); // the mirror would cost what packing saves
+    bytes_dirty_ = false;
+}
+
+std::size_t SearchScratch::memory_bytes() const {
+    return (seen.capacity() + closed.capacity()) * sizeof(std::uint32_t) +
+           (g.capacity() + parent.capacity()) * sizeof(int) +
+           seen_bits.memory_bytes() + closed_bits.memory_bytes() +
+           open.capacity() * sizeof(OpenList<std::uint64_t>::Entry);
+}
+
+std::size_t Planner::memory_bytes() const {
+    return grid_.capacity() + cells_.memory_bytes() + jump_.capacity() * sizeof(int) + scratch_.memory_bytes() +
+           flow_dist_.capacity() * sizeof(int) + flow_open_.capacity() + flow_dir_.capacity();
+}
 
 std::vector<std::pair<int,int>> Planner::plan(int sx, int sy, int gx, int gy) {
+    stats_ = {};
+    sync_storage();
+    if (opts_.mode == PlannerMode::BFS) return plan_bfs(sx, sy, gx, gy);
+    if (opts_.mode == PlannerMode::JPS && opts_.connectivity == Connectivity::Eight) return plan_jps(sx, sy, gx, gy);
+    if (opts_.mode == PlannerMode::FlowField) return plan_flow(sx, sy, gx, gy);
+    return plan_astar(sx, sy, gx, gy);
+}
+
+void Planner::set_cell(int x, int y, uint8_t value) {
+    if (!in_bounds(x, y)) return;
+    sync_storage();
+    if (packed()) cells_.set(x, y, value != 0);
+    else grid_[y*w_ + x] = value;
+    flow_stale_ = true;
+    if (caches_stale_ || jump_.empty()) return;
+    // forced-neighbour tests look one row/column to either side
+    for (int r = std::max(0, y - 1); r <= std::min(h_ - 1, y + 1); ++r) jump_row_dirty_[r] = 1;
+    for (int c = std::max(0, x - 1); c <= std::min(w_ - 1, x + 1); ++c) jump_col_dirty_[c] = 1;
+}
+
+std::vector<std::pair<int,int>> Planner::plan_bfs(int sx, int sy, int gx, int gy) {
     // Basic BFS (no bounds checks robustness) intentionally naive.
     std::vector<int> visited(w_*h_, 0);
     std::queue<GridNode> q;
@@ -13,7 +153,9 @@ std::vector<std::pair<int,int>> Planner::plan(int sx, int sy, int gx, int gy) {
     std::vector<std::pair<int,int>> path;
     while (!q.empty()) {
         auto n = q.front(); q.pop();
+        ++stats_.expanded;
         if (n.x == gx && n.y == gy) {
+            stats_.cost = n.cost * kStraightCost;
             path.push_back({n.x,n.y});
             return path; // returns only goal (no reconstruction) intentionally incomplete
         }
@@ -23,9 +165,10 @@ std::vector<std::pair<int,int>> Planner::plan(int sx, int sy, int gx, int gy) {
             int ny = n.y + d[1];
             if (nx>=0 && nx<w_ && ny>=0 && ny<h_) {
                 int idx = ny*w_ + nx;
-                if (!visited[idx] && grid_[idx]==0) {
+                if (!visited[idx] && free_cell(nx, ny)) {
                     visited[idx]=1;
                     q.push({nx,ny,n.cost+1});
+                    ++stats_.pushed;
                 }
             }
         }
@@ -33,4 +176,148 @@ std::vector<std::pair<int,int>> Planner::plan(int sx, int sy, int gx, int gy) {
     return path; // empty if no path
 }
 
+int Planner::heuristic(int x, int y, int gx, int gy) const {
+    const int dx = std::abs(x - gx), dy = std::abs(y - gy);
+    if (opts_.connectivity == Connectivity::Four) return kStraightCost * (dx + dy);
+    return kStraightCost * std::max(dx, dy) + (kDiagonalCost - kStraightCost) * std::min(dx, dy);
+}
+
+int Planner::step_cost(int x, int y, int k) const {
+    const Step& s = kSteps[k];
+    const int nx = x + s.dx, ny = y + s.dy;
+    if (!free_cell(nx, ny)) return 0;
+    // diagonal moves need both orthogonal neighbours free (no corner cutting)
+    if (s.dx != 0 && s.dy != 0 && (!free_cell(nx, y) || !free_cell(x, ny))) return 0;
+    return s.cost;
+}
+
+void Planner::reserve_scratch(SearchScratch& s) const {
+    const auto n = static_cast<std::size_t>(w_) * static_cast<std::size_t>(h_);
+    if (s.g.size() != n) {
+        s.g.resize(n);
+        s.parent.resize(n);
+    }
+    s.open.clear();
+}
+
+void Planner::begin_packed_search(SearchScratch& s) const {
+    reserve_scratch(s);
+    const auto n = static_cast<std::size_t>(w_) * static_cast<std::size_t>(h_);
+    s.seen_bits.reset(n);
+    s.closed_bits.reset(n);
+}
+
+void Planner::begin_search(SearchScratch& s) const {
+    reserve_scratch(s);
+    const auto n = static_cast<std::size_t>(w_) * static_cast<std::size_t>(h_);
+    if (s.seen.size() != n) {
+        s.seen.assign(n, 0);
+        s.closed.assign(n, 0);
+        s.search_id = 0;
+    }
+    if (++s.search_id == 0) { // wrapped: stale stamps could alias, clear once
+        std::fill(s.seen.begin(), s.seen.end(), 0);
+        std::fill(s.closed.begin(), s.closed.end(), 0);
+        s.search_id = 1;
+    }
+}
+
+bool Planner::closed(const SearchScratch& s, int cell) const {
+    return packed() ? s.closed_bits.test(static_cast<std::size_t>(cell)) : s.closed[cell] == s.search_id;
+}
+
+std::vector<std::pair<int,int>> Planner::reconstruct(const SearchScratch& s, int goal) const {
+    std::vector<std::pair<int,int>> path;
+    for (int i = goal; i >= 0; i = s.parent[i]) path.push_back({i % w_, i / w_});
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::vector<std::pair<int,int>> Planner::plan_astar(int sx, int sy, int gx, int gy) {
+    if (!free_cell(sx, sy) || !free_cell(gx, gy)) return {};
+    const int start = sy*w_ + sx, goal = gy*w_ + gx;
+    SingleTarget target{*this, goal, gx, gy};
+    run_search(scratch_, stats_, start, target);
+    if (!closed(scratch_, goal)) return {};
+    stats_.cost = scratch_.g[goal];
+    return reconstruct(scratch_, goal);
+}
+
+bool Planner::plan_into(int sx, int sy, int gx, int gy, SearchScratch& scratch, PlannerStats& stats,
+                        std::vector<std::uint32_t>& out) const {
+    stats = {};
+    if (!free_cell(sx, sy) || !free_cell(gx, gy)) return false;
+    const int start = sy*w_ + sx, goal = gy*w_ + gx;
+    SingleTarget target{*this, goal, gx, gy};
+    run_search(scratch, stats, start, target);
+    if (!closed(scratch, goal)) return false;
+    stats.cost = scratch.g[goal];
+    const auto first = out.size();
+    for (int i = goal; i >= 0; i = scratch.parent[i]) out.push_back(static_cast<std::uint32_t>(i));
+    std::reverse(out.begin() + static_cast<std::ptrdiff_t>(first), out.end());
+    return true;
+}
+
+void Planner::settle_from(int goal, std::span<const int> targets, SearchScratch& scratch, PlannerStats& stats) const {
+    stats = {};
+    if (!free_cell(goal % w_, goal / w_)) return;
+    SettleTargets target{targets, targets.size()};
+    run_search(scratch, stats, goal, target);
+}
+
+bool Planner::trace_settled(const SearchScratch& scratch, int start, std::vector<std::uint32_t>& out) const {
+    if (!closed(scratch, start)) return false;
+    for (int i = start; i >= 0; i = scratch.parent[i]) out.push_back(static_cast<std::uint32_t>(i));
+    return true;
+}
+
+template <typename Target>
+void Planner::run_search(SearchScratch& s, PlannerStats& stats, int start, Target& target) const {
+    if (packed()) {
+        begin_packed_search(s);
+        BitVisited visited{s.seen_bits, s.closed_bits};
+        best_first(PackedCells{cells_}, visited, s, stats, start, target);
+    } else {
+        begin_search(s);
+        StampVisited visited{s.seen.data(), s.closed.data(), s.search_id};
+        best_first(ByteCells{grid_.data(), w_, h_, step_count()}, visited, s, stats, start, target);
+    }
+}
+
+template <typename Cells, typename Visited, typename Target>
+void Planner::best_first(const Cells& cells, Visited& visited, SearchScratch& s, PlannerStats& stats,
+                         int start, Target& target) const {
+    const unsigned step_mask = opts_.connectivity == Connectivity::Four ? 0x0Fu : 0xFFu;
+
+    visited.mark_seen(start);
+    s.g[start] = 0;
+    s.parent[start] = -1;
+    s.open.push(open_key(target.h(start % w_, start / w_), 0), start);
+    ++stats.pushed;
+
+    while (!s.open.empty()) {
+        const int cur = s.open.pop().node;
+        if (visited.is_closed(cur)) continue; // stale duplicate
+        visited.mark_closed(cur);
+        ++stats.expanded;
+        if (target.reached(cur)) return;
+        const int cx = cur % w_, cy = cur / w_;
+        // one neighbourhood probe yields every legal move, corner rule included
+        unsigned legal = kLegalMoves[cells.blocked_neighbors(cx, cy)] & step_mask;
+        for (; legal != 0; legal &= legal - 1) {
+            const Step& st = kSteps[std::countr_zero(legal)];
+            const int nx = cx + st.dx, ny = cy + st.dy;
+            const int nb = ny*w_ + nx;
+            if (visited.is_closed(nb)) continue;
+            const int ng = s.g[cur] + st.cost;
+            if (visited.is_seen(nb) && ng >= s.g[nb]) continue;
+            visited.mark_seen(nb);
+            s.g[nb] = ng;
+            s.parent[nb] = cur;
+            s.open.push(open_key(ng + target.h(nx, ny), ng), nb);
+            ++stats.pushed;
+        }
+    }
+}
+
 } // namespace robokit
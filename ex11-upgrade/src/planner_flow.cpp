@@ -0,0 +1,193 @@
+#include "robokit/planner.hpp"
+#include <algorithm>
+#include <bit>
+
+// Flow field (many-to-one routing). A chamfer distance transform with the
+// planner's own step costs is relaxed by alternating downward and upward row
+// sweeps until nothing changes; on open maps that takes a couple of passes,
+// cluttered maps and mazes one more per reversal of the shortest paths. Each
+// sweep first relaxes a whole row from its neighbour row (no intra-row
+// dependency, branch-free, so the compiler can vectorize it) and then runs
+// the short left/right scans.
+// Paths then follow the steepest descent, one table lookup per step.
+
+namespace robokit {
+
+namespace {
+
+constexpr int kInf = 1 << 29; // kInf + kInf + kDiagonalCost still fits in int
+
+// Relax row `y` (padded coordinates) from row `y + dy` (dy = -1 or +1).
+// Returns true if any distance dropped.
+template <bool Diagonal>
+bool relax_from_row(int* d, const uint8_t* open, int stride, int w, int y, int dy) {
+    int* row = d + static_cast<std::ptrdiff_t>(y) * stride;
+    const int* nb = row + static_cast<std::ptrdiff_t>(dy) * stride;
+    const uint8_t* o = open + static_cast<std::ptrdiff_t>(y) * stride;
+    const uint8_t* on = o + static_cast<std::ptrdiff_t>(dy) * stride;
+    int changed = 0;
+    for (int x = 1; x <= w; ++x) {
+        int best = std::min(row[x], nb[x] + Planner::kStraightCost);
+        if constexpr (Diagonal) {
+            // no corner cutting: both orthogonal cells of the diagonal must be open
+            const int left = nb[x-1] + Planner::kDiagonalCost + kInf * (1 - (o[x-1] & on[x]));
+            const int right = nb[x+1] + Planner::kDiagonalCost + kInf * (1 - (o[x+1] & on[x]));
+            best = std::min(best, std::min(left, right));
+        }
+        const int v = o[x] ? best : kInf;
+        changed |= v != row[x];
+        row[x] = v;
+    }
+    return changed != 0;
+}
+
+// Left-to-right then right-to-left scan along row `y`.
+bool relax_along_row(int* d, const uint8_t* open, int stride, int w, int y) {
+    int* row = d + static_cast<std::ptrdiff_t>(y) * stride;
+    const uint8_t* o = open + static_cast<std::ptrdiff_t>(y) * stride;
+    bool changed = false;
+    for (int x = 2; x <= w; ++x) {
+        if (o[x] && row[x-1] + Planner::kStraightCost < row[x]) {
+            row[x] = row[x-1] + Planner::kStraightCost;
+            changed = true;
+        }
+    }
+    for (int x = w - 1; x >= 1; --x) {
+        if (o[x] && row[x+1] + Planner::kStraightCost < row[x]) {
+            row[x] = row[x+1] + Planner::kStraightCost;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+// Alternate downward and upward passes until no row changes. A row is only
+// revisited once the neighbour row a pass reads from dropped since then, so
+// early passes touch just the band around the wavefront and late ones the few
+// rows still settling. `dirty` is padded like the rows (h + 2 entries): bit 0
+// = row above changed, bit 1 = row below changed.
+template <bool Diagonal>
+int sweep_to_convergence(int* d, const uint8_t* open, uint8_t* dirty, int stride, int w, int h,
+                         std::size_t& rows_visited) {
+    int sweeps = 0;
+    auto visit = [&](int y, int dy, uint8_t bit, bool& any) {
+        if (!(dirty[y] & bit)) return;
+        dirty[y] &= static_cast<uint8_t>(~bit);
+        ++rows_visited;
+        bool changed = relax_from_row<Diagonal>(d, open, stride, w, y, dy);
+        changed |= relax_along_row(d, open, stride, w, y);
+        if (changed) {
+            dirty[y-1] |= 2;
+            dirty[y+1] |= 1;
+            any = true;
+        }
+    };
+    for (bool any = true; any;) {
+        any = false;
+        for (int y = 1; y <= h; ++y) visit(y, -1, 1, any);
+        for (int y = h; y >= 1; --y) visit(y, +1, 2, any);
+        sweeps += 2;
+    }
+    return sweeps;
+}
+
+} // namespace
+
+void Planner::flow_load_occupancy() {
+    const int stride = w_ + 2;
+    const auto n = static_cast<std::size_t>(stride) * static_cast<std::size_t>(h_ + 2);
+    flow_open_.assign(n, 0);
+    flow_dist_.assign(n, kInf);
+    for (int y = 0; y < h_; ++y) {
+        uint8_t* o = flow_open_.data() + static_cast<std::size_t>(y + 1) * stride + 1;
+        if (packed()) {
+            for (int x = 0; x < w_; ++x) o[x] = !cells_.blocked(x, y);
+        } else {
+            const uint8_t* g = grid_.data() + static_cast<std::size_t>(y) * w_;
+            for (int x = 0; x < w_; ++x) o[x] = g[x] == 0;
+        }
+    }
+}
+
+void Planner::flow_directions() {
+    const int stride = w_ + 2;
+    const unsigned step_mask = opts_.connectivity == Connectivity::Four ? 0x0Fu : 0xFFu;
+    flow_dir_.assign(static_cast<std::size_t>(w_) * h_, 0xFF);
+    for (int y = 0; y < h_; ++y) {
+        for (int x = 0; x < w_; ++x) {
+            const int p = (y + 1) * stride + (x + 1);
+            if (flow_dist_[p] >= kInf || flow_dist_[p] == 0) continue;
+            unsigned blocked = 0;
+            for (int k = 0; k < 8; ++k)
+                if (!flow_open_[p + kSteps[k].dy * stride + kSteps[k].dx]) blocked |= 1u << k;
+            int best = flow_dist_[p], best_k = -1;
+            for (unsigned legal = kLegalMoves[blocked] & step_mask; legal != 0; legal &= legal - 1) {
+                const int k = std::countr_zero(legal);
+                const int v = flow_dist_[p + kSteps[k].dy * stride + kSteps[k].dx] + kSteps[k].cost;
+                if (v <= best) {
+                    best = v;
+                    best_k = k;
+                }
+            }
+            flow_dir_[static_cast<std::size_t>(y) * w_ + x] = static_cast<uint8_t>(best_k);
+        }
+    }
+}
+
+bool Planner::build_flow_field(int gx, int gy) {
+    sync_storage();
+    if (!free_cell(gx, gy)) {
+        flow_goal_ = -1;
+        return false;
+    }
+    const int goal = gy*w_ + gx;
+    if (!flow_stale_ && flow_goal_ == goal) return true;
+
+    flow_load_occupancy();
+    const int stride = w_ + 2;
+    flow_dist_[(gy + 1) * stride + gx + 1] = 0;
+    // everything but the goal row starts at a (trivial) fixed point; the goal
+    // row and both rows next to it are seeded, as the goal's own row scans
+    // change nothing when it is walled in left and right
+    std::vector<uint8_t> dirty(static_cast<std::size_t>(h_) + 2, 0);
+    dirty[gy] = 2;
+    dirty[gy + 1] = 1;
+    dirty[gy + 2] = 1;
+    std::size_t rows = 0;
+    flow_sweeps_ = opts_.connectivity == Connectivity::Four
+        ? sweep_to_convergence<false>(flow_dist_.data(), flow_open_.data(), dirty.data(), stride, w_, h_, rows)
+        : sweep_to_convergence<true>(flow_dist_.data(), flow_open_.data(), dirty.data(), stride, w_, h_, rows);
+    flow_cells_relaxed_ = rows * static_cast<std::size_t>(w_);
+    flow_directions();
+    flow_goal_ = goal;
+    flow_stale_ = false;
+    return true;
+}
+
+int Planner::flow_distance(int x, int y) const {
+    if (flow_goal_ < 0 || !in_bounds(x, y)) return -1;
+    const int d = flow_dist_[(y + 1) * (w_ + 2) + x + 1];
+    return d >= kInf ? -1 : d;
+}
+
+std::optional<std::pair<int,int>> Planner::flow_next(int x, int y) const {
+    if (flow_goal_ < 0 || !in_bounds(x, y)) return std::nullopt;
+    const uint8_t k = flow_dir_[static_cast<std::size_t>(y) * w_ + x];
+    if (k == 0xFF) return std::nullopt;
+    return std::make_pair(x + kSteps[k].dx, y + kSteps[k].dy);
+}
+
+std::vector<std::pair<int,int>> Planner::plan_flow(int sx, int sy, int gx, int gy) {
+    const bool reused = !flow_stale_ && flow_goal_ == gy*w_ + gx;
+    if (!build_flow_field(gx, gy)) return {};
+    // a fresh field counts every cell relaxation; a reused one costs only the walk
+    if (!reused) stats_.expanded = flow_cells_relaxed_;
+    const int cost = flow_distance(sx, sy);
+    if (cost < 0) return {};
+    stats_.cost = cost;
+    std::vector<std::pair<int,int>> path{{sx, sy}};
+    while (auto next = flow_next(path.back().first, path.back().second)) path.push_back(*next);
+    return path;
+}
+
+} // namespace robokit
@@ -0,0 +1,207 @@
+#include "robokit/planner.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+// Jump Point Search (8-connected, no corner cutting). Straight jumps come from
+// a precomputed JPS+ style table so a search touches only jump points; diagonal
+// jumps walk the diagonal and probe the table for each cell.
+
+namespace robokit {
+
+namespace {
+
+enum Dir { East = 0, West = 1, South = 2, North = 3 };
+
+int sign(int v) { return (v > 0) - (v < 0); }
+
+} // namespace
+
+void Planner::jps_prepare() {
+    const auto n = static_cast<std::size_t>(w_) * static_cast<std::size_t>(h_);
+    if (jump_.size() != 4 * n) {
+        jump_.assign(4 * n, 0);
+        jump_row_dirty_.assign(h_, 1);
+        jump_col_dirty_.assign(w_, 1);
+    } else if (caches_stale_) {
+        std::fill(jump_row_dirty_.begin(), jump_row_dirty_.end(), 1);
+        std::fill(jump_col_dirty_.begin(), jump_col_dirty_.end(), 1);
+    }
+    caches_stale_ = false;
+}
+
+void Planner::jps_rebuild_row(int y) {
+    // moving along x into (x,y) forces a turn if a side cell opens up behind it
+    auto forced = [&](int x, int dx) {
+        return (free_cell(x, y-1) && !free_cell(x-dx, y-1)) || (free_cell(x, y+1) && !free_cell(x-dx, y+1));
+    };
+    int* row = jump_.data() + static_cast<std::size_t>(y) * w_ * 4;
+    for (int x = w_ - 1; x >= 0; --x) {
+        const int nx = x + 1;
+        int v = 0;
+        if (!free_cell(nx, y)) v = 0;
+        else if (forced(nx, 1)) v = 1;
+        else { const int p = row[nx*4 + East]; v = p > 0 ? p + 1 : p - 1; }
+        row[x*4 + East] = v;
+    }
+    for (int x = 0; x < w_; ++x) {
+        const int nx = x - 1;
+        int v = 0;
+        if (!free_cell(nx, y)) v = 0;
+        else if (forced(nx, -1)) v = 1;
+        else { const int p = row[nx*4 + West]; v = p > 0 ? p + 1 : p - 1; }
+        row[x*4 + West] = v;
+    }
+    jump_row_dirty_[y] = 0;
+}
+
+void Planner::jps_rebuild_col(int x) {
+    auto forced = [&](int y, int dy) {
+        return (free_cell(x-1, y) && !free_cell(x-1, y-dy)) || (free_cell(x+1, y) && !free_cell(x+1, y-dy));
+    };
+    auto at = [&](int y, int dir) -> int& { return jump_[(static_cast<std::size_t>(y) * w_ + x) * 4 + dir]; };
+    for (int y = h_ - 1; y >= 0; --y) {
+        const int ny = y + 1;
+        int v = 0;
+        if (!free_cell(x, ny)) v = 0;
+        else if (forced(ny, 1)) v = 1;
+        else { const int p = at(ny, South); v = p > 0 ? p + 1 : p - 1; }
+        at(y, South) = v;
+    }
+    for (int y = 0; y < h_; ++y) {
+        const int ny = y - 1;
+        int v = 0;
+        if (!free_cell(x, ny)) v = 0;
+        else if (forced(ny, -1)) v = 1;
+        else { const int p = at(ny, North); v = p > 0 ? p + 1 : p - 1; }
+        at(y, North) = v;
+    }
+    jump_col_dirty_[x] = 0;
+}
+
+// Jump from (x,y) along a cardinal direction; returns the jump point (or the
+// goal if it lies on the way) as a cell index, -1 if the ray dies at a wall.
+int Planner::jps_straight(int x, int y, int dir, int goal) {
+    const bool horizontal = dir == East || dir == West;
+    if (horizontal ? jump_row_dirty_[y] : jump_col_dirty_[x]) {
+        if (horizontal) jps_rebuild_row(y); else jps_rebuild_col(x);
+    }
+    const int d = jump_[(static_cast<std::size_t>(y) * w_ + x) * 4 + dir];
+    const int span = d > 0 ? d : -d;
+    const int step = (dir == East || dir == South) ? 1 : -1;
+    const int gx = goal % w_, gy = goal / w_;
+    if (horizontal && gy == y) {
+        const int along = (gx - x) * step;
+        if (along > 0 && along <= span) return goal;
+    } else if (!horizontal && gx == x) {
+        const int along = (gy - y) * step;
+        if (along > 0 && along <= span) return goal;
+    }
+    if (d <= 0) return -1;
+    return horizontal ? y*w_ + x + step*d : (y + step*d)*w_ + x;
+}
+
+// Walk the diagonal from (x,y); the first step must already be known legal.
+int Planner::jps_diagonal(int x, int y, int dx, int dy, int goal) {
+    const int hdir = dx > 0 ? East : West;
+    const int vdir = dy > 0 ? South : North;
+    for (;;) {
+        x += dx;
+        y += dy;
+        const int idx = y*w_ + x;
+        if (idx == goal) return idx;
+        if (jps_straight(x, y, hdir, goal) >= 0 || jps_straight(x, y, vdir, goal) >= 0) return idx;
+        if (!free_cell(x+dx, y) || !free_cell(x, y+dy) || !free_cell(x+dx, y+dy)) return -1;
+    }
+}
+
+std::vector<std::pair<int,int>> Planner::plan_jps(int sx, int sy, int gx, int gy) {
+    if (!free_cell(sx, sy) || !free_cell(gx, gy)) return {};
+    const int start = sy*w_ + sx, goal = gy*w_ + gx;
+
+    jps_prepare();
+    SearchScratch& s = scratch_;
+    begin_search(s);
+    const std::uint32_t sid = s.search_id;
+
+    s.seen[start] = sid;
+    s.g[start] = 0;
+    s.parent[start] = -1;
+    s.open.push(open_key(heuristic(sx, sy, gx, gy), 0), start);
+    ++stats_.pushed;
+
+    struct Dir2 { int dx, dy; };
+    Dir2 dirs[8];
+    while (!s.open.empty()) {
+        const int cur = s.open.pop().node;
+        if (s.closed[cur] == sid) continue;
+        s.closed[cur] = sid;
+        ++stats_.expanded;
+        if (cur == goal) break;
+
+        const int cx = cur % w_, cy = cur / w_;
+        int n_dirs = 0;
+        if (s.parent[cur] < 0) {
+            for (int dy = -1; dy <= 1; ++dy)
+                for (int dx = -1; dx <= 1; ++dx)
+                    if (dx != 0 || dy != 0) dirs[n_dirs++] = {dx, dy};
+        } else {
+            // pruned successors; without corner cutting only straight moves have forced neighbours
+            const int dx = sign(cx - s.parent[cur] % w_), dy = sign(cy - s.parent[cur] / w_);
+            if (dx != 0 && dy != 0) {
+                dirs[n_dirs++] = {dx, 0};
+                dirs[n_dirs++] = {0, dy};
+                dirs[n_dirs++] = {dx, dy};
+            } else if (dx != 0) {
+                dirs[n_dirs++] = {dx, 0};
+                dirs[n_dirs++] = {dx, 1};
+                dirs[n_dirs++] = {dx, -1};
+                dirs[n_dirs++] = {0, 1};
+                dirs[n_dirs++] = {0, -1};
+            } else {
+                dirs[n_dirs++] = {0, dy};
+                dirs[n_dirs++] = {1, dy};
+                dirs[n_dirs++] = {-1, dy};
+                dirs[n_dirs++] = {1, 0};
+                dirs[n_dirs++] = {-1, 0};
+            }
+        }
+
+        for (int k = 0; k < n_dirs; ++k) {
+            const auto [dx, dy] = dirs[k];
+            int j = -1;
+            if (dx != 0 && dy != 0) {
+                if (!free_cell(cx+dx, cy) || !free_cell(cx, cy+dy) || !free_cell(cx+dx, cy+dy)) continue;
+                j = jps_diagonal(cx, cy, dx, dy, goal);
+            } else {
+                const int dir = dx > 0 ? East : dx < 0 ? West : dy > 0 ? South : North;
+                j = jps_straight(cx, cy, dir, goal);
+            }
+            if (j < 0 || s.closed[j] == sid) continue;
+            const int jx = j % w_, jy = j / w_;
+            const int dist = std::max(std::abs(jx - cx), std::abs(jy - cy));
+            const int ng = s.g[cur] + dist * (dx != 0 && dy != 0 ? kDiagonalCost : kStraightCost);
+            if (s.seen[j] == sid && ng >= s.g[j]) continue;
+            s.seen[j] = sid;
+            s.g[j] = ng;
+            s.parent[j] = cur;
+            s.open.push(open_key(ng + heuristic(jx, jy, gx, gy), ng), j);
+            ++stats_.pushed;
+        }
+    }
+    if (s.closed[goal] != sid) return {};
+
+    // Parent links join jump points by straight or diagonal segments; expand them.
+    stats_.cost = s.g[goal];
+    std::vector<std::pair<int,int>> path;
+    for (int i = goal; s.parent[i] >= 0; i = s.parent[i]) {
+        const int px = s.parent[i] % w_, py = s.parent[i] / w_;
+        int x = i % w_, y = i / w_;
+        const int dx = sign(px - x), dy = sign(py - y);
+        for (; x != px || y != py; x += dx, y += dy) path.push_back({x, y});
+    }
+    path.push_back({sx, sy});
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+} // namespace robokit
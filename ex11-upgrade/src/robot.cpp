@@ -1,8 +1,10 @@
 #include "robokit/robot.hpp"
+#include <algorithm>
 
 namespace robokit {
 
-Robot::Robot(std::string name, std::size_t dof) : name_(std::move(name)), joints_(dof) {}
+Robot::Robot(std::string name, std::size_t dof, Clock& clock)
+    : name_(std::move(name)), joints_(dof), state_(dof), clock_(&clock) {}
 
 Robot::~Robot() {
     // manual delete of owned sensors (ownership is unclear by design)
@@ -11,7 +13,22 @@ Robot::~Robot() {
     }
 }
 
+std::size_t SensorBase::read_batch(std::span<double> values, std::span<Timestamp> stamps) {
+    const std::size_t n = std::min(values.size(), stamps.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        values[i] = read();
+        stamps[i] = now();
+    }
+    return n;
+}
+
+void Robot::set_clock(Clock& clock) {
+    clock_ = &clock;
+    for (auto* s : sensors_) s->set_clock(clock);
+}
+
 void Robot::add_sensor(SensorBase* s) {
+    s->set_clock(*clock_);
     sensors_.push_back(s);
 }
 
@@ -0,0 +1,105 @@
+#include "robokit/scheduler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#if defined(__linux__)
+#include <cerrno>
+#include <time.h>
+#endif
+
+namespace robokit {
+
+void TimingStats::record(std::chrono::nanoseconds lateness) {
+    const std::int64_t ns = std::max<std::int64_t>(0, lateness.count());
+    const auto bucket = std::min<std::size_t>(static_cast<std::size_t>(ns / 1000), kBuckets - 1);
+    hist_[bucket].fetch_add(1, std::memory_order_relaxed);
+    sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+    std::int64_t prev = max_ns_.load(std::memory_order_relaxed);
+    while (ns > prev && !max_ns_.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {}
+    ticks_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TimingStats::record_overrun(std::uint64_t skipped_ticks) {
+    overruns_.fetch_add(1, std::memory_order_relaxed);
+    skipped_.fetch_add(skipped_ticks, std::memory_order_relaxed);
+}
+
+void TimingStats::reset() {
+    ticks_ = 0;
+    overruns_ = 0;
+    skipped_ = 0;
+    sum_ns_ = 0;
+    max_ns_ = 0;
+    for (auto& b : hist_) b.store(0, std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds TimingStats::max_jitter() const {
+    return std::chrono::nanoseconds(max_ns_.load(std::memory_order_relaxed));
+}
+
+std::chrono::nanoseconds TimingStats::mean_jitter() const {
+    const auto n = ticks();
+    if (n == 0) return std::chrono::nanoseconds(0);
+    return std::chrono::nanoseconds(sum_ns_.load(std::memory_order_relaxed) / static_cast<std::int64_t>(n));
+}
+
+std::chrono::nanoseconds TimingStats::percentile(double p) const {
+    std::uint64_t total = 0;
+    for (const auto& b : hist_) total += b.load(std::memory_order_relaxed);
+    if (total == 0) return std::chrono::nanoseconds(0);
+    const auto target = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(std::clamp(p, 0.0, 1.0) * static_cast<double>(total))));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBuckets - 1; ++i) {
+        seen += hist_[i].load(std::memory_order_relaxed);
+        if (seen >= target) return std::chrono::microseconds(i + 1);
+    }
+    return max_jitter(); // overflow bucket: best answer we have
+}
+
+DeadlineScheduler::DeadlineScheduler(clock::duration period, OverrunPolicy policy, Clock& time)
+    : period_(period > clock::duration::zero() ? period : clock::duration(1)), policy_(policy), time_(&time),
+      next_(time.now()) {}
+
+void DeadlineScheduler::reset(clock::time_point start) {
+    next_ = start;
+    stats_.reset();
+}
+
+bool DeadlineScheduler::wait_next(std::stop_token st) {
+    if (st.stop_requested()) return false;
+    next_ += period_;
+    auto now = time_->now();
+    if (now > next_) {
+        // Previous tick ran past this deadline.
+        std::uint64_t missed = 0;
+        if (policy_ == OverrunPolicy::Skip) {
+            missed = static_cast<std::uint64_t>((now - next_) / period_) + 1;
+            next_ += period_ * static_cast<clock::rep>(missed);
+        }
+        stats_.record_overrun(missed);
+        if (policy_ == OverrunPolicy::CatchUp) {
+            stats_.record(now - next_);
+            return !st.stop_requested();
+        }
+    }
+    time_->sleep_until(next_);
+    stats_.record(time_->now() - next_);
+    return !st.stop_requested();
+}
+
+void sleep_until_abs(std::chrono::steady_clock::time_point tp) {
+#if defined(__linux__)
+    // steady_clock is CLOCK_MONOTONIC on Linux (libstdc++ and libc++).
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+    if (ns <= 0) return;
+    timespec ts{};
+    ts.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+    ts.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+#else
+    std::this_thread::sleep_until(tp);
+#endif
+}
+
+} // namespace robokit
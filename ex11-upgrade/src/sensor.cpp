@@ -1,19 +1,76 @@
 #include "robokit/sensor.hpp"
+#include <algorithm>
 #include <cmath>
-#include <random>
 
 namespace robokit {
 
+namespace {
+
+double seconds(Timestamp t) {
+    return std::chrono::duration<double>(t.time_since_epoch()).count();
+}
+
+// Stamps a burst of n samples `period` apart, starting at max(now, next),
+// and moves `next` past it.
+void stamp_batch(std::span<Timestamp> stamps, Timestamp now, SensorClock::duration period, Timestamp& next) {
+    const Timestamp start = std::max(now, next);
+    for (std::size_t i = 0; i < stamps.size(); ++i) stamps[i] = start + static_cast<SensorClock::rep>(i) * period;
+    next = start + static_cast<SensorClock::rep>(stamps.size()) * period;
+}
+
+} // namespace
+
+NoisySineSensor::NoisySineSensor(double freq, SensorClock::duration period, std::uint64_t seed)
+    : freq_(freq), period_(period), rng_(seed) {
+    const double step = freq_ * std::chrono::duration<double>(period_).count();
+    for (std::size_t i = 0; i < kBlock; ++i) {
+        sin_step_[i] = std::sin(step * static_cast<double>(i));
+        cos_step_[i] = std::cos(step * static_cast<double>(i));
+    }
+}
+
 double NoisySineSensor::read() {
-    std::uniform_real_distribution<double> noise(-0.01, 0.01);
-    double t = static_cast<double>(std::chrono::steady_clock::now().time_since_epoch().count()) * 1e-9;
-    return std::sin(freq_ * t) + noise(rng_);
+    return std::sin(freq_ * seconds(now())) + rng_.uniform(-0.01, 0.01);
+}
+
+std::size_t NoisySineSensor::read_batch(std::span<double> values, std::span<Timestamp> stamps) {
+    const std::size_t n = std::min(values.size(), stamps.size());
+    stamp_batch(stamps.first(n), now(), period_, next_);
+    rng_.uniform(values.first(n), -0.01, 0.01);
+    for (std::size_t b = 0; b < n; b += kBlock) {
+        const double phase = freq_ * seconds(stamps[b]);
+        const double s0 = std::sin(phase), c0 = std::cos(phase);
+        const std::size_t m = std::min(kBlock, n - b);
+        for (std::size_t i = 0; i < m; ++i) values[b + i] += s0 * cos_step_[i] + c0 * sin_step_[i];
+    }
+    return n;
 }
 
 double RandomWalkSensor::read() {
-    std::uniform_real_distribution<double> step(-0.05, 0.05);
-    value_ += step(rng_);
+    value_ += rng_.uniform(-0.05, 0.05);
     return value_;
 }
 
+std::size_t RandomWalkSensor::read_batch(std::span<double> values, std::span<Timestamp> stamps) {
+    const std::size_t n = std::min(values.size(), stamps.size());
+    stamp_batch(stamps.first(n), now(), period_, next_);
+    rng_.uniform(values.first(n), -0.05, 0.05);
+    for (std::size_t i = 0; i < n; ++i) values[i] = value_ += values[i];
+    return n;
+}
+
+std::size_t SensorStream::poll(std::size_t count) {
+    constexpr std::size_t kChunk = 64;
+    std::array<double, kChunk> values;
+    std::array<Timestamp, kChunk> stamps;
+    std::size_t done = 0;
+    while (done < count) {
+        const std::size_t n = sensor_.read_batch(std::span(values).first(std::min(kChunk, count - done)), stamps);
+        if (n == 0) break;
+        for (std::size_t i = 0; i < n; ++i) ring_.push({stamps[i], values[i]});
+        done += n;
+    }
+    return done;
+}
+
 } // namespace robokit
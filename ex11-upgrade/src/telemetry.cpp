@@ -0,0 +1,366 @@
+#include "robokit/telemetry.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ROBOKIT_HAS_MMAP 1
+#endif
+
+namespace robokit {
+
+namespace {
+
+constexpr char kMagic[8] = {'R', 'K', 'T', 'E', 'L', 'E', 'M', '1'};
+constexpr std::size_t kHeaderBytes = 4096;
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t dof, channels;
+    std::uint32_t frames_per_block, blocks_per_index;
+    std::uint64_t frames;
+    std::int64_t origin;
+    char names[TelemetryWriter::kMaxChannels][TelemetryWriter::kMaxNameBytes + 1];
+};
+static_assert(sizeof(FileHeader) <= kHeaderBytes);
+
+using detail::TelemetryIndexEntry;
+
+constexpr std::size_t round_up(std::size_t n, std::size_t to) { return (n + to - 1) / to * to; }
+
+struct Geometry {
+    std::size_t block_frames, blocks_per_index, column_stride, block_bytes, index_bytes, segment_bytes;
+};
+
+Geometry geometry(std::size_t frames_per_block, std::size_t blocks_per_index, std::size_t dof, std::size_t channels) {
+    Geometry g{};
+    g.block_frames = round_up(std::max<std::size_t>(frames_per_block, 1), 8);
+    g.blocks_per_index = std::max<std::size_t>(blocks_per_index, 1);
+    // one cache line of padding per column: with power-of-two blocks the
+    // columns would otherwise all map to the same L1 set, and a row write
+    // (one store per column) would miss on every store
+    g.column_stride = g.block_frames + 8;
+    g.block_bytes = g.column_stride * sizeof(double) * (1 + 2 * dof + channels);
+    g.index_bytes = round_up(g.blocks_per_index * sizeof(TelemetryIndexEntry), 64);
+    g.segment_bytes = g.index_bytes + g.blocks_per_index * g.block_bytes;
+    return g;
+}
+
+// a * b, false on overflow
+bool mul(std::size_t a, std::size_t b, std::size_t& out) {
+    if (b != 0 && a > static_cast<std::size_t>(-1) / b) return false;
+    out = a * b;
+    return true;
+}
+
+// geometry() for untrusted header fields: false if any size overflows
+bool checked_geometry(const FileHeader& h, Geometry& g) {
+    const std::size_t fpb = h.frames_per_block, bpi = h.blocks_per_index;
+    const std::size_t columns = 1 + 2 * std::size_t{h.dof} + h.channels; // 32-bit fields: cannot overflow
+    std::size_t block_bytes = 0, blocks_bytes = 0;
+    if (!mul(fpb + 8, sizeof(double), block_bytes) || !mul(block_bytes, columns, block_bytes)) return false;
+    const std::size_t index_bytes = round_up(bpi * sizeof(TelemetryIndexEntry), 64);
+    if (!mul(bpi, block_bytes, blocks_bytes) || blocks_bytes > static_cast<std::size_t>(-1) - index_bytes) return false;
+    g = geometry(fpb, bpi, h.dof, h.channels);
+    return true;
+}
+
+} // namespace
+
+// ---- writer ----
+
+bool TelemetryWriter::open(const std::string& path, std::size_t dof, std::span<const std::string> channels,
+                           Timestamp origin, TelemetryOptions opts) {
+    close();
+    if (channels.size() > kMaxChannels) return false;
+#if defined(ROBOKIT_HAS_MMAP)
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) return false;
+    const Geometry g = geometry(opts.frames_per_block, opts.blocks_per_index, dof, channels.size());
+    dof_ = dof;
+    channels_ = channels.size();
+    block_frames_ = g.block_frames;
+    column_stride_ = g.column_stride;
+    blocks_per_index_ = g.blocks_per_index;
+    block_bytes_ = g.block_bytes;
+    index_bytes_ = g.index_bytes;
+    segment_bytes_ = g.segment_bytes;
+    const std::size_t segment_frames = block_frames_ * blocks_per_index_;
+    const std::size_t segments = std::max<std::size_t>((opts.reserve_frames + segment_frames - 1) / segment_frames, 1);
+    if (!map(kHeaderBytes + segments * segment_bytes_)) {
+        close();
+        return false;
+    }
+    auto* h = reinterpret_cast<FileHeader*>(map_);
+    std::memcpy(h->magic, kMagic, sizeof kMagic);
+    h->dof = static_cast<std::uint32_t>(dof_);
+    h->channels = static_cast<std::uint32_t>(channels_);
+    h->frames_per_block = static_cast<std::uint32_t>(block_frames_);
+    h->blocks_per_index = static_cast<std::uint32_t>(blocks_per_index_);
+    h->frames = 0;
+    h->origin = origin.time_since_epoch().count();
+    for (std::size_t c = 0; c < channels_; ++c)
+        channels[c].copy(h->names[c], kMaxNameBytes); // the rest of the fresh mapping is zero
+    return true;
+#else
+    (void)path, (void)dof, (void)origin, (void)opts;
+    return false;
+#endif
+}
+
+bool TelemetryWriter::open(const std::string& path, const Robot& robot, TelemetryOptions opts) {
+    std::vector<std::string> names;
+    for (const auto* s : robot.sensors()) names.emplace_back(s->name());
+    return open(path, robot.joints().size(), names, robot.clock().now(), opts);
+}
+
+bool TelemetryWriter::map(std::size_t bytes) {
+#if defined(ROBOKIT_HAS_MMAP)
+    if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) return false;
+    if (map_) ::munmap(map_, mapped_);
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+        map_ = nullptr;
+        mapped_ = 0;
+        return false;
+    }
+    map_ = static_cast<std::byte*>(p);
+    mapped_ = bytes;
+    return true;
+#else
+    (void)bytes;
+    return false;
+#endif
+}
+
+void TelemetryWriter::close() {
+#if defined(ROBOKIT_HAS_MMAP)
+    std::size_t used = kHeaderBytes;
+    if (frames_ > 0) { // up to the end of the last block touched
+        const std::uint64_t blocks = (frames_ + block_frames_ - 1) / block_frames_;
+        const std::uint64_t last = blocks - 1;
+        used += (last / blocks_per_index_) * segment_bytes_ + index_bytes_ + (last % blocks_per_index_ + 1) * block_bytes_;
+    }
+    if (map_) ::munmap(map_, mapped_);
+    if (fd_ >= 0) {
+        if (map_) (void)::ftruncate(fd_, static_cast<off_t>(used));
+        ::close(fd_);
+    }
+#endif
+    fd_ = -1;
+    map_ = nullptr;
+    mapped_ = 0;
+    frames_ = 0;
+    row_ = 0;
+    stamps_ = nullptr;
+    columns_ = nullptr;
+    entry_ = nullptr;
+}
+
+double* TelemetryWriter::begin_row(Timestamp stamp) {
+    const Timestamp::rep t = stamp.time_since_epoch().count();
+    if (!map_ || (frames_ > 0 && t < last_stamp_)) return nullptr;
+    if (row_ == 0) { // first row of a new block
+        const std::uint64_t b = frames_ / block_frames_;
+        const std::size_t segment = static_cast<std::size_t>(b / blocks_per_index_);
+        const std::size_t slot = static_cast<std::size_t>(b % blocks_per_index_);
+        const std::size_t seg_off = kHeaderBytes + segment * segment_bytes_;
+        const std::size_t block_off = seg_off + index_bytes_ + slot * block_bytes_;
+        if (block_off + block_bytes_ > mapped_ && !map(std::max(mapped_ * 2, block_off + block_bytes_))) return nullptr;
+        entry_ = reinterpret_cast<TelemetryIndexEntry*>(map_ + seg_off) + slot;
+        entry_->first_stamp = t;
+        stamps_ = reinterpret_cast<Timestamp::rep*>(map_ + block_off);
+        columns_ = reinterpret_cast<double*>(stamps_ + column_stride_);
+    }
+    return columns_ + row_;
+}
+
+void TelemetryWriter::end_row(Timestamp stamp) {
+    const Timestamp::rep t = stamp.time_since_epoch().count();
+    stamps_[row_] = t;
+    entry_->last_stamp = t;
+    entry_->frames = static_cast<std::uint32_t>(row_ + 1);
+    last_stamp_ = t;
+    reinterpret_cast<FileHeader*>(map_)->frames = ++frames_;
+    if (++row_ == block_frames_) row_ = 0;
+}
+
+bool TelemetryWriter::append(Timestamp stamp, std::span<const double> positions, std::span<const double> velocities,
+                             std::span<const double> channels) {
+    if (positions.size() != dof_ || velocities.size() != dof_ || channels.size() != channels_) return false;
+    double* col = begin_row(stamp);
+    if (!col) return false;
+    for (double v : positions) { *col = v; col += column_stride_; }
+    for (double v : velocities) { *col = v; col += column_stride_; }
+    for (double v : channels) { *col = v; col += column_stride_; }
+    end_row(stamp);
+    return true;
+}
+
+bool TelemetryWriter::record(Timestamp stamp, const Robot& robot, std::span<const double> channels) {
+    const JointStore& joints = robot.joints();
+    return append(stamp, joints.positions(), joints.velocities(), channels);
+}
+
+// ---- reader ----
+
+bool TelemetryReader::open(const std::string& path) {
+    close();
+#if defined(ROBOKIT_HAS_MMAP)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < kHeaderBytes) {
+        ::close(fd);
+        return false;
+    }
+    const std::size_t size = static_cast<std::size_t>(st.st_size);
+    void* p = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps the file alive
+    if (p == MAP_FAILED) return false;
+    map_ = static_cast<const std::byte*>(p);
+    mapped_ = size;
+
+    // every header field may be garbage (the file may come from a crashed run)
+    const auto* h = reinterpret_cast<const FileHeader*>(map_);
+    Geometry g{};
+    if (std::memcmp(h->magic, kMagic, sizeof kMagic) != 0 || h->channels > TelemetryWriter::kMaxChannels ||
+        h->frames_per_block == 0 || h->frames_per_block % 8 != 0 || h->blocks_per_index == 0 ||
+        !checked_geometry(*h, g) ||
+        (h->frames > 0 && g.index_bytes + g.block_bytes > mapped_ - kHeaderBytes)) {
+        close();
+        return false;
+    }
+    dof_ = h->dof;
+    origin_ = Timestamp(Timestamp::duration(h->origin));
+    block_frames_ = g.block_frames;
+    column_stride_ = g.column_stride;
+    blocks_per_index_ = g.blocks_per_index;
+    block_bytes_ = g.block_bytes;
+    index_bytes_ = g.index_bytes;
+    segment_bytes_ = g.segment_bytes;
+    for (std::size_t c = 0; c < h->channels; ++c)
+        names_.emplace_back(h->names[c], strnlen(h->names[c], TelemetryWriter::kMaxNameBytes));
+
+    // only frames in blocks that lie wholly inside the file count
+    const std::size_t avail = mapped_ - kHeaderBytes;
+    const std::size_t segments = avail / segment_bytes_;
+    const std::size_t rest = avail - segments * segment_bytes_;
+    const std::size_t tail_blocks = rest < index_bytes_ ? 0 : std::min((rest - index_bytes_) / block_bytes_, blocks_per_index_);
+    const std::size_t fit = segments * blocks_per_index_ + tail_blocks;
+    // and the index knows how far each was filled: written blocks are a
+    // prefix with non-zero counts, all full but the last
+    auto entry = [&](std::size_t b) {
+        return reinterpret_cast<const TelemetryIndexEntry*>(map_ + kHeaderBytes + (b / blocks_per_index_) * segment_bytes_) +
+               b % blocks_per_index_;
+    };
+    std::size_t lo = 0, hi = fit; // first unwritten block
+    while (lo < hi) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (entry(mid)->frames > 0) lo = mid + 1; else hi = mid;
+    }
+    const std::uint64_t written =
+        lo == 0 ? 0 : std::uint64_t{lo - 1} * block_frames_ + std::min<std::size_t>(entry(lo - 1)->frames, block_frames_);
+    frames_ = std::min<std::uint64_t>(h->frames, written);
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+void TelemetryReader::close() {
+#if defined(ROBOKIT_HAS_MMAP)
+    if (map_) ::munmap(const_cast<std::byte*>(map_), mapped_);
+#endif
+    map_ = nullptr;
+    mapped_ = 0;
+    names_.clear();
+    frames_ = 0;
+}
+
+const std::byte* TelemetryReader::block_base(std::size_t b) const {
+    return map_ + kHeaderBytes + (b / blocks_per_index_) * segment_bytes_ + index_bytes_ + (b % blocks_per_index_) * block_bytes_;
+}
+
+const double* TelemetryReader::row(std::uint64_t frame, std::size_t column) const {
+    const auto* stamps = reinterpret_cast<const Timestamp::rep*>(block_base(static_cast<std::size_t>(frame / block_frames_)));
+    return reinterpret_cast<const double*>(stamps + column_stride_) + column * column_stride_ + frame % block_frames_;
+}
+
+Timestamp TelemetryReader::stamp(std::uint64_t frame) const {
+    const auto* stamps = reinterpret_cast<const Timestamp::rep*>(block_base(static_cast<std::size_t>(frame / block_frames_)));
+    return Timestamp(Timestamp::duration(stamps[frame % block_frames_]));
+}
+
+double TelemetryReader::value(std::uint64_t frame, std::size_t channel) const { return *row(frame, 2 * dof_ + channel); }
+
+void TelemetryReader::read_joints(std::uint64_t frame, JointStore& out) const {
+    const double* p = row(frame, 0);
+    const std::span<double> q = out.positions(), v = out.velocities();
+    const std::size_t n = std::min(out.size(), dof_);
+    for (std::size_t j = 0; j < n; ++j) {
+        q[j] = p[j * column_stride_];
+        v[j] = p[(dof_ + j) * column_stride_];
+    }
+}
+
+void TelemetryReader::read_channels(std::uint64_t frame, std::span<double> out) const {
+    const double* p = row(frame, 2 * dof_);
+    const std::size_t n = std::min(out.size(), names_.size());
+    for (std::size_t c = 0; c < n; ++c) out[c] = p[c * column_stride_];
+}
+
+TelemetryReader::Block TelemetryReader::block(std::size_t b) const {
+    const auto* stamps = reinterpret_cast<const Timestamp::rep*>(block_base(b));
+    const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(frames_ - std::uint64_t{b} * block_frames_, block_frames_));
+    return {{stamps, n}, reinterpret_cast<const double*>(stamps + column_stride_), column_stride_, dof_};
+}
+
+std::uint64_t TelemetryReader::upper_bound(Timestamp t) const {
+    if (frames_ == 0) return 0;
+    const Timestamp::rep key = t.time_since_epoch().count();
+    const std::size_t blocks = block_count();
+    const std::size_t segments = (blocks + blocks_per_index_ - 1) / blocks_per_index_;
+    auto index = [&](std::size_t segment) {
+        return reinterpret_cast<const TelemetryIndexEntry*>(map_ + kHeaderBytes + segment * segment_bytes_);
+    };
+    // last segment, then last block, whose first frame is at or before t
+    std::size_t lo = 0, hi = segments;
+    while (lo < hi) {
+        const std::size_t mid = (lo + hi) / 2;
+        if (index(mid)->first_stamp <= key) lo = mid + 1; else hi = mid;
+    }
+    if (lo == 0) return 0;
+    const std::size_t segment = lo - 1;
+    const TelemetryIndexEntry* entries = index(segment);
+    const std::size_t used = std::min(blocks - segment * blocks_per_index_, blocks_per_index_);
+    const std::size_t slot = static_cast<std::size_t>(
+        std::upper_bound(entries, entries + used, key, [](Timestamp::rep k, const TelemetryIndexEntry& e) { return k < e.first_stamp; }) -
+        entries) - 1;
+    const Block blk = block(segment * blocks_per_index_ + slot);
+    const auto rows = std::upper_bound(blk.stamps.begin(), blk.stamps.end(), key) - blk.stamps.begin();
+    return std::uint64_t{segment * blocks_per_index_ + slot} * block_frames_ + static_cast<std::uint64_t>(rows);
+}
+
+// ---- replay ----
+
+double ReplaySensor::read() {
+    const std::uint64_t n = log_.frames();
+    if (n == 0) return 0.0;
+    const Timestamp t = now();
+    if (next_ > 0 && next_ <= n && log_.stamp(next_ - 1) > t) next_ = log_.upper_bound(t); // clock went back
+    while (next_ < n && log_.stamp(next_) <= t) {
+        if (next_ + 64 < n && log_.stamp(next_ + 64) <= t) { // far behind: jump
+            next_ = log_.upper_bound(t);
+            break;
+        }
+        ++next_;
+    }
+    return log_.value(next_ == 0 ? 0 : next_ - 1, channel_);
+}
+
+} // namespace robokit
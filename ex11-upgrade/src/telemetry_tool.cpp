@@ -0,0 +1,120 @@
+#include "robokit/control_loop.hpp"
+#include "robokit/planner.hpp"
+#include "robokit/robot.hpp"
+#include "robokit/sensor.hpp"
+#include "robokit/telemetry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// robokit_telemetry: records a simulated run to a telemetry file, or replays
+// one through a ControlLoop at full speed. Replay diffs the joint state after
+// each control tick against the next recorded frame, so a recording made
+// before a change is a regression check for it (--max-diff), and the replay
+// loop doubles as a profiling harness for the control body.
+//
+//   robokit_telemetry record <file> [--seconds 60] [--dof 6] [--rate-hz 1000]
+//   robokit_telemetry replay <file> [--max-diff 1e-9]
+
+using namespace robokit;
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int record(const std::string& path, double seconds, std::size_t dof, double rate_hz) {
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / rate_hz));
+    VirtualClock clock;
+    Robot robot("telemetry_bot", dof, clock);
+    robot.add_sensor(new NoisySineSensor(1.0, period));
+    robot.add_sensor(new RandomWalkSensor(period));
+    Planner planner(10, 10);
+    ControlLoop loop(robot, planner, {.period = period});
+
+    TelemetryWriter writer;
+    TelemetryOptions opts;
+    opts.reserve_frames = static_cast<std::size_t>(seconds * rate_hz) + 1;
+    if (!writer.open(path, robot, opts)) {
+        std::cerr << "cannot create " << path << "\n";
+        return 1;
+    }
+    std::vector<double> values(robot.sensors().size());
+    std::chrono::steady_clock::duration in_record{};
+    bool ok = true;
+    loop.add_task("record", period, [&] {
+        const auto sensors = robot.sensors();
+        for (std::size_t c = 0; c < sensors.size(); ++c) values[c] = sensors[c]->read();
+        const auto t0 = std::chrono::steady_clock::now();
+        ok = writer.record(clock.now(), robot, values) && ok;
+        in_record += std::chrono::steady_clock::now() - t0;
+    });
+    const auto t0 = std::chrono::steady_clock::now();
+    loop.simulate(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds)));
+    const double wall = seconds_since(t0);
+    const auto frames = writer.frames();
+    writer.close();
+    const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(in_record).count());
+    std::cout << "{\"mode\":\"record\",\"frames\":" << frames << ",\"dof\":" << dof << ",\"channels\":" << values.size()
+              << ",\"ns_per_frame\":" << (frames ? ns / static_cast<double>(frames) : 0.0) << ",\"wall_s\":" << wall
+              << "}\n";
+    return ok ? 0 : 1;
+}
+
+int replay(const std::string& path, double max_diff) {
+    TelemetryReader log;
+    if (!log.open(path) || log.frames() == 0) {
+        std::cerr << "cannot read " << path << " (or no frames)\n";
+        return 1;
+    }
+    VirtualClock clock;
+    Robot robot("replay_bot", log.dof(), clock);
+    for (std::size_t c = 0; c < log.channel_count(); ++c) robot.add_sensor(new ReplaySensor(log, c));
+    Planner planner(10, 10);
+    ControlLoop loop(robot, planner);
+
+    JointStore expected(log.dof());
+    double worst = 0.0;
+    const auto t0 = std::chrono::steady_clock::now();
+    const auto frames = loop.replay(log, [&](std::uint64_t f) {
+        if (f + 1 >= log.frames()) return;
+        log.read_joints(f + 1, expected);
+        const auto q = robot.joints().positions(), want = expected.positions();
+        for (std::size_t j = 0; j < q.size(); ++j) worst = std::max(worst, std::fabs(q[j] - want[j]));
+    });
+    const double wall = seconds_since(t0);
+    std::cout << "{\"mode\":\"replay\",\"frames\":" << frames << ",\"dof\":" << log.dof()
+              << ",\"channels\":" << log.channel_count() << ",\"frames_per_s\":" << (wall > 0 ? static_cast<double>(frames) / wall : 0.0)
+              << ",\"max_abs_diff\":" << worst << "}\n";
+    if (frames == 0) return 1;
+    return max_diff >= 0 && worst > max_diff ? 1 : 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: robokit_telemetry record <file> [--seconds S] [--dof N] [--rate-hz R]\n"
+                     "       robokit_telemetry replay <file> [--max-diff X]\n";
+        return 2;
+    }
+    const std::string mode = argv[1], path = argv[2];
+    double seconds = 60, rate_hz = 1000, max_diff = -1;
+    std::size_t dof = 6;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        const std::string a = argv[i];
+        if (a == "--seconds") seconds = std::atof(argv[i + 1]);
+        else if (a == "--dof") dof = static_cast<std::size_t>(std::atoi(argv[i + 1]));
+        else if (a == "--rate-hz") rate_hz = std::atof(argv[i + 1]);
+        else if (a == "--max-diff") max_diff = std::atof(argv[i + 1]);
+    }
+    if (mode == "record" && seconds > 0 && rate_hz > 0) return record(path, seconds, dof, rate_hz);
+    if (mode == "replay") return replay(path, max_diff);
+    std::cerr << "unknown mode or bad arguments\n";
+    return 2;
+}
@@ -0,0 +1,63 @@
+#include "robokit/thread_pool.hpp"
+#include <algorithm>
+
+namespace robokit {
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    workers_.reserve(threads - 1);
+    for (std::size_t w = 1; w < threads; ++w) {
+        workers_.emplace_back([this, w](std::stop_token st) { worker_loop(st, w); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    for (auto& w : workers_) w.request_stop();
+    workers_.clear(); // stop_token wakes the condition variable; jthread joins
+}
+
+void ThreadPool::run_chunks(std::size_t worker) {
+    for (;;) {
+        const std::size_t begin = next_.fetch_add(grain_, std::memory_order_relaxed);
+        if (begin >= n_) return;
+        (*fn_)(begin, std::min(begin + grain_, n_), worker);
+    }
+}
+
+void ThreadPool::worker_loop(std::stop_token st, std::size_t worker) {
+    std::uint64_t seen = 0;
+    std::unique_lock lk(mtx_);
+    for (;;) {
+        if (!wake_cv_.wait(lk, st, [&] { return generation_ != seen; })) return;
+        seen = generation_;
+        lk.unlock();
+        run_chunks(worker);
+        lk.lock();
+        if (--pending_ == 0) done_cv_.notify_one();
+    }
+}
+
+void ThreadPool::parallel_for(std::size_t n, std::size_t grain, const ChunkFn& fn) {
+    if (n == 0) return;
+    grain = std::max<std::size_t>(1, grain);
+    if (workers_.empty() || n <= grain) {
+        fn(0, n, 0);
+        return;
+    }
+    std::lock_guard submit(submit_mtx_);
+    {
+        std::lock_guard lk(mtx_);
+        fn_ = &fn;
+        n_ = n;
+        grain_ = grain;
+        next_.store(0, std::memory_order_relaxed);
+        pending_ = workers_.size();
+        ++generation_;
+    }
+    wake_cv_.notify_all();
+    run_chunks(0);
+    std::unique_lock lk(mtx_);
+    done_cv_.wait(lk, [&] { return pending_ == 0; });
+}
+
+} // namespace robokit
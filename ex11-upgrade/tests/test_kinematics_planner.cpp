@@ -1,9 +1,34 @@
 #include "robokit/kinematics.hpp"
+#include "robokit/fixed_kinematics.hpp"
+#include "robokit/linalg.hpp"
+#include "robokit/gemm.hpp"
+#include "robokit/math_util.hpp"
 #include "robokit/planner.hpp"
+#include "robokit/incremental_planner.hpp"
+#include "robokit/hierarchical_planner.hpp"
+#include "robokit/batch_planner.hpp"
+#include "robokit/occupancy_grid.hpp"
 #include "robokit/robot.hpp"
 #include "robokit/sensor.hpp"
+#include "robokit/counter_rng.hpp"
+#include "robokit/scheduler.hpp"
+#include "robokit/control_loop.hpp"
+#include "robokit/executor.hpp"
+#include "robokit/logging.hpp"
+#include "robokit/async_logger.hpp"
+#include "robokit/config.hpp"
+#include "robokit/telemetry.hpp"
 #include <vector>
+#include <utility>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <chrono>
+#include <random>
+#include <thread>
 #include "vendor/doctest.h"
 
 using namespace robokit;
@@ -22,6 +47,302 @@ TEST_CASE(test_inverse_kinematics_trivial){
     REQUIRE(r->size() == 4);
 }
 
+static_assert(FixedKinematics<3>::link_angles(std::array<double, 3>{0.5, 0.25, -1.0})[2] == -0.25);
+
+template <std::size_t N>
+static void check_fixed_kinematics(std::mt19937& rng) {
+    std::uniform_real_distribution<double> angle(-3.0, 3.0);
+    typename FixedKinematics<N>::Joints q;
+    for (auto& a : q) a = angle(rng);
+    // reference: the generic runtime loop
+    double x = 0.0, y = 0.0, phi = 0.0;
+    for (double a : q) {
+        phi += a;
+        x += std::cos(phi);
+        y += std::sin(phi);
+    }
+    const auto pose = FixedKinematics<N>::forward(q);
+    REQUIRE(pose.x == x && pose.y == y && pose.theta == phi);
+    const auto via_runtime = Kinematics::forward(std::vector<double>(q.begin(), q.end()));
+    REQUIRE(via_runtime.x == x && via_runtime.y == y && via_runtime.theta == phi);
+
+    const auto J = FixedKinematics<N>::jacobian(q);
+    for (std::size_t j = 0; j < N; ++j) {
+        auto qp = q;
+        qp[j] += 1e-7;
+        const auto pp = FixedKinematics<N>::forward(qp);
+        REQUIRE(std::fabs((pp.x - pose.x) / 1e-7 - J[0][j]) < 1e-5);
+        REQUIRE(std::fabs((pp.y - pose.y) / 1e-7 - J[1][j]) < 1e-5);
+    }
+}
+
+TEST_CASE(test_fixed_kinematics_matches_runtime){
+    std::mt19937 rng(9);
+    for (int trial = 0; trial < 10; ++trial) {
+        check_fixed_kinematics<1>(rng);
+        check_fixed_kinematics<2>(rng);
+        check_fixed_kinematics<3>(rng);
+        check_fixed_kinematics<5>(rng);
+        check_fixed_kinematics<7>(rng);
+    }
+}
+
+TEST_CASE(test_ik_dls_reaches_random_poses){
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> angle(-1.5, 1.5);
+    for (std::size_t dof = 3; dof <= 7; ++dof) {
+        for (int trial = 0; trial < 20; ++trial) {
+            std::vector<double> q(dof);
+            for (auto& a : q) a = angle(rng);
+            const auto target = Kinematics::forward(q);
+            auto r = Kinematics::inverse(target, dof);
+            REQUIRE(r.has_value());
+            const auto pose = Kinematics::forward(*r);
+            REQUIRE(std::fabs(pose.x - target.x) < 1e-6);
+            REQUIRE(std::fabs(pose.y - target.y) < 1e-6);
+            REQUIRE(std::fabs(std::remainder(pose.theta - target.theta, 2.0 * 3.141592653589793)) < 1e-6);
+        }
+    }
+    REQUIRE(!Kinematics::inverse(Pose2D{5.0, 0.0, 0.0}, 4).has_value()); // beyond reach
+    REQUIRE(!Kinematics::inverse(Pose2D{1.0, 0.0, 0.0}, IkSolver::kMaxDof + 1).has_value());
+}
+
+TEST_CASE(test_ik_closed_form_2r_3r){
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<double> angle(-3.0, 3.0);
+    for (int trial = 0; trial < 100; ++trial) {
+        const std::vector<double> q = {angle(rng), angle(rng), angle(rng)};
+        const auto target3 = Kinematics::forward(q);
+        const auto target2 = Kinematics::forward({q[0], q[1]});
+        for (auto elbow : {Elbow::Up, Elbow::Down}) {
+            const auto a = Kinematics::inverse_2r(target2, elbow);
+            REQUIRE(a.has_value());
+            REQUIRE(elbow == Elbow::Up ? (*a)[1] <= 0.0 : (*a)[1] >= 0.0);
+            const auto p2 = Kinematics::forward({(*a)[0], (*a)[1]});
+            REQUIRE(std::fabs(p2.x - target2.x) < 1e-9 && std::fabs(p2.y - target2.y) < 1e-9);
+
+            const auto b = Kinematics::inverse(target3, 3, elbow);
+            REQUIRE(b.has_value());
+            const auto p3 = Kinematics::forward(*b);
+            REQUIRE(std::fabs(p3.x - target3.x) < 1e-9 && std::fabs(p3.y - target3.y) < 1e-9);
+            REQUIRE(std::fabs(std::remainder(p3.theta - target3.theta, 2.0 * 3.141592653589793)) < 1e-9);
+        }
+    }
+    REQUIRE(!Kinematics::inverse_2r(Pose2D{2.5, 0.0, 0.0}).has_value());
+    REQUIRE(!Kinematics::inverse(Pose2D{3.0, 0.5, 0.0}, 3).has_value());
+    const auto folded = Kinematics::inverse_2r(Pose2D{0.0, 0.0, 0.0}); // target at the base
+    REQUIRE(folded.has_value() && std::fabs(std::fabs((*folded)[1]) - 3.141592653589793) < 1e-12);
+}
+
+TEST_CASE(test_ik_warm_start_tracks_in_few_iterations){
+    IkSolver ik(5);
+    std::vector<double> q = {0.3, -0.2, 0.5, 0.4, -0.1};
+    REQUIRE(ik.solve(Kinematics::forward(q)).converged);
+    int worst = 0;
+    for (int step = 0; step < 200; ++step) {
+        for (std::size_t j = 0; j < q.size(); ++j) q[j] += 0.002 * static_cast<double>(j + 1);
+        const auto r = ik.solve(Kinematics::forward(q));
+        REQUIRE(r.converged);
+        worst = std::max(worst, r.iterations);
+    }
+    REQUIRE(worst <= 2);
+}
+
+TEST_CASE(test_ik_respects_joint_limits){
+    IkSolver ik(4);
+    const std::vector<double> lo(4, -0.6), hi(4, 0.6);
+    ik.set_limits(lo, hi);
+    const auto target = Kinematics::forward({0.5, 0.4, -0.3, 0.55});
+    ik.seed(std::vector<double>{-0.5, 0.0, 0.5, 0.0});
+    const auto r = ik.solve(target);
+    REQUIRE(r.converged);
+    for (double a : ik.joints()) REQUIRE(a >= -0.6 && a <= 0.6);
+}
+
+TEST_CASE(test_fk_cache_updates_from_first_changed_joint){
+    std::vector<double> q = {0.3, -0.4, 0.2, 0.9, -1.1, 0.5, 0.05};
+    FkCache fk(q.size());
+    fk.set_joints(q);
+    auto expect = Kinematics::forward(q);
+    auto pose = fk.pose();
+    REQUIRE(pose.x == expect.x && pose.y == expect.y && pose.theta == expect.theta);
+    REQUIRE(fk.links_updated() == 7);
+
+    q[6] += 0.01; // wrist only
+    fk.set_joint(6, q[6]);
+    pose = fk.pose();
+    expect = Kinematics::forward(q);
+    REQUIRE(pose.x == expect.x && pose.y == expect.y && pose.theta == expect.theta);
+    REQUIRE(fk.links_updated() == 8);
+
+    fk.set_joints(q); // unchanged: nothing to redo
+    fk.pose();
+    REQUIRE(fk.links_updated() == 8);
+
+    q[4] -= 0.2;
+    q[2] += 0.1;
+    fk.set_joint(4, q[4]);
+    fk.set_joint(2, q[2]);
+    pose = fk.pose();
+    expect = Kinematics::forward(q);
+    REQUIRE(pose.x == expect.x && pose.y == expect.y && pose.theta == expect.theta);
+    REQUIRE(fk.links_updated() == 13); // links 2..6
+    const auto elbow = fk.link(1);
+    const auto expect_elbow = Kinematics::forward({q[0], q[1]});
+    REQUIRE(elbow.x == expect_elbow.x && elbow.y == expect_elbow.y);
+}
+
+TEST_CASE(test_forward_batch_matches_forward){
+    constexpr std::size_t dof = 7, count = 37, stride = 40; // odd tail, padded rows
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> angle(-3.5, 3.5);
+    std::vector<double> angles(dof * stride, 0.0);
+    for (auto& a : angles) a = angle(rng);
+    angles[3 * stride + 9] = 1e7; // beyond the SIMD reduction range: scalar fallback
+    std::vector<double> x(count), y(count), theta(count);
+    for (auto level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        REQUIRE(Kinematics::forward_batch({angles, dof, count, stride}, {x, y, theta}, level));
+        for (std::size_t i = 0; i < count; ++i) {
+            std::vector<double> joints(dof);
+            for (std::size_t j = 0; j < dof; ++j) joints[j] = angles[j * stride + i];
+            const auto pose = Kinematics::forward(joints);
+            const double tol = level == SimdLevel::Scalar ? 0.0 : 1e-12;
+            REQUIRE(std::fabs(x[i] - pose.x) <= tol);
+            REQUIRE(std::fabs(y[i] - pose.y) <= tol);
+            REQUIRE(theta[i] == pose.theta);
+        }
+    }
+    std::vector<double> short_x(count - 1);
+    REQUIRE(!Kinematics::forward_batch({angles, dof, count, stride}, {short_x, y, theta}));
+    REQUIRE(!Kinematics::forward_batch({std::span<const double>(angles).first(100), dof, count, stride}, {x, y, theta}));
+}
+
+static_assert(linalg::Mat<int, 2, 2>::identity() * linalg::Vec<int, 2>{{3, 4}} == linalg::Vec<int, 2>{{3, 4}});
+
+TEST_CASE(test_linalg_fixed_products){
+    std::mt19937 rng(12);
+    std::uniform_real_distribution<double> val(-2.0, 2.0);
+    linalg::Mat4d a, b;
+    linalg::Vec4d x;
+    for (auto& v : a.m) v = val(rng);
+    for (auto& v : b.m) v = val(rng);
+    for (auto& v : x.v) v = val(rng);
+    const auto y = a * x;
+    const auto ab = a * b;
+    for (std::size_t r = 0; r < 4; ++r) {
+        double sum = 0.0;
+        for (std::size_t c = 0; c < 4; ++c) {
+            sum += a(r, c) * x[c];
+            double abrc = 0.0;
+            for (std::size_t k = 0; k < 4; ++k) abrc += a(r, k) * b(k, c);
+            REQUIRE(std::fabs(ab(r, c) - abrc) < 1e-12);
+        }
+        REQUIRE(std::fabs(y[r] - sum) < 1e-12);
+    }
+    linalg::Mat<double, 3, 5> j;
+    linalg::Vec3d u{{0.5, -1.0, 2.0}};
+    for (auto& v : j.m) v = val(rng);
+    const auto jt_u = linalg::transpose_mul(j, u);
+    const auto ref = linalg::transpose(j) * u;
+    for (std::size_t c = 0; c < 5; ++c) REQUIRE(std::fabs(jt_u[c] - ref[c]) < 1e-12);
+    const auto g = linalg::mul_transposed(j);
+    const auto g_ref = j * linalg::transpose(j);
+    for (std::size_t i = 0; i < 9; ++i) REQUIRE(std::fabs(g.m[i] - g_ref.m[i]) < 1e-12);
+}
+
+TEST_CASE(test_linalg_solve_and_views){
+    linalg::Mat3d a;
+    a.m = {4.0, 1.0, 0.5, 1.0, 3.0, -1.0, 0.5, -1.0, 2.0};
+    const linalg::Vec3d want{{1.0, -2.0, 0.25}};
+    linalg::Vec3d x;
+    REQUIRE(linalg::solve(a, a * want, x));
+    for (std::size_t i = 0; i < 3; ++i) REQUIRE(std::fabs(x[i] - want[i]) < 1e-12);
+    linalg::Mat3d singular;
+    singular.m = {1.0, 2.0, 3.0, 2.0, 4.0, 6.0, 0.0, 1.0, 1.0};
+    REQUIRE(!linalg::solve(singular, want, x));
+    // generic over the scalar type
+    linalg::Mat<float, 2, 2> af;
+    af.m = {2.0f, 1.0f, 1.0f, 3.0f};
+    linalg::Vec<float, 2> xf;
+    REQUIRE(linalg::solve(af, linalg::Vec<float, 2>{{3.0f, 4.0f}}, xf));
+    REQUIRE(std::fabs(xf[0] - 1.0f) < 1e-6f && std::fabs(xf[1] - 1.0f) < 1e-6f);
+
+    // 3x5 matrix stored with a row stride of 8, compared with the legacy mat_vec
+    std::vector<double> storage(3 * 8, 99.0), packed;
+    for (std::size_t r = 0; r < 3; ++r)
+        for (std::size_t c = 0; c < 5; ++c) packed.push_back(storage[r * 8 + c] = 0.5 * static_cast<double>(r) - static_cast<double>(c));
+    const std::vector<double> v = {1.0, 2.0, -1.0, 0.5, 3.0};
+    std::vector<double> y = {1.0, 1.0, 1.0};
+    const linalg::MatView<const double> view(storage.data(), 3, 5, 8);
+    REQUIRE(linalg::gemv(view, v, y, 2.0, 1.0));
+    const auto ref = mat_vec(packed, 3, 5, v);
+    for (std::size_t r = 0; r < 3; ++r) REQUIRE(std::fabs(y[r] - (2.0 * ref[r] + 1.0)) < 1e-12);
+    REQUIRE(!linalg::gemv(view, std::span<const double>(v).first(4), y));
+
+    // quarter turn plus translation, applied in place
+    const auto t = linalg::rigid2d(1.0, 2.0, 3.141592653589793 / 2.0);
+    std::vector<double> px = {1.0, 0.0, 2.0, 3.0, -1.0}, py = {0.0, 1.0, 2.0, 0.0, 0.5};
+    const auto px0 = px, py0 = py;
+    REQUIRE(linalg::transform_points(t, px, py, px, py));
+    for (std::size_t i = 0; i < px.size(); ++i) {
+        REQUIRE(std::fabs(px[i] - (1.0 - py0[i])) < 1e-12);
+        REQUIRE(std::fabs(py[i] - (2.0 + px0[i])) < 1e-12);
+    }
+}
+
+TEST_CASE(test_gemm_matches_naive_across_edges_and_threads){
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> d(-1.0, 1.0);
+    ThreadPool pool(3);
+    // sizes straddle the 4x8 register tile and the 96 / 256 cache blocks
+    for (auto [m, k, n] : {std::array<std::size_t, 3>{1, 1, 1}, {5, 3, 9}, {97, 257, 13}, {200, 300, 17}}) {
+        std::vector<double> a(m * k), b(k * n), c(m * (n + 3), 7.0);
+        for (auto& v : a) v = d(rng);
+        for (auto& v : b) v = d(rng);
+        const auto c0 = c;
+        // C is written through a row stride of n + 3; the padding must survive
+        linalg::MatView<double> cv(c.data(), m, n, n + 3);
+        REQUIRE(linalg::gemm({a.data(), m, k}, {b.data(), k, n}, cv, 0.5, -2.0, m > 50 ? &pool : nullptr));
+        std::vector<double> col(k);
+        for (std::size_t j = 0; j < n; ++j) {
+            for (std::size_t p = 0; p < k; ++p) col[p] = b[p * n + j];
+            const auto ref = mat_vec(a, static_cast<int>(m), static_cast<int>(k), col);
+            for (std::size_t i = 0; i < m; ++i) REQUIRE(std::fabs(cv(i, j) - (0.5 * ref[i] - 2.0 * 7.0)) < 1e-12);
+        }
+        for (std::size_t i = 0; i < m; ++i)
+            for (std::size_t j = n; j < n + 3; ++j) REQUIRE(c[i * (n + 3) + j] == c0[i * (n + 3) + j]);
+    }
+    std::vector<double> a(6), b(6), c(4);
+    REQUIRE(!linalg::gemm({a.data(), 2, 3}, {b.data(), 2, 3}, {c.data(), 2, 2}));
+}
+
+TEST_CASE(test_parallel_gemv_and_cloud_transform){
+    ThreadPool pool(3);
+    const std::size_t rows = 301, cols = 45;
+    std::vector<double> a(rows * cols), x(cols), y(rows, 1.0);
+    for (std::size_t i = 0; i < a.size(); ++i) a[i] = std::sin(static_cast<double>(i));
+    for (std::size_t i = 0; i < cols; ++i) x[i] = 0.1 * static_cast<double>(i);
+    REQUIRE(linalg::gemv({a.data(), rows, cols}, x, y, -1.0, 3.0, pool));
+    const auto ref = mat_vec(a, static_cast<int>(rows), static_cast<int>(cols), x);
+    for (std::size_t r = 0; r < rows; ++r) REQUIRE(std::fabs(y[r] - (3.0 - ref[r])) < 1e-12);
+    REQUIRE(!linalg::gemv({a.data(), rows, cols}, std::span<const double>(x).first(3), y, 1.0, 0.0, pool));
+
+    // pose as a 4x4 against mat_vec on homogeneous points, in place, 10k points
+    linalg::Mat4d t = linalg::Mat4d::identity();
+    t.m = {0.0, -1.0, 0.0, 1.0,  1.0, 0.0, 0.0, 2.0,  0.0, 0.0, 1.0, -0.5,  0.0, 0.0, 0.0, 1.0};
+    const std::vector<double> tm(t.m.begin(), t.m.end());
+    std::vector<double> pts(10'000 * 3);
+    for (std::size_t i = 0; i < pts.size(); ++i) pts[i] = std::cos(0.37 * static_cast<double>(i));
+    const auto before = pts;
+    linalg::MatView<double> cloud(pts.data(), 10'000, 3);
+    REQUIRE(linalg::transform_cloud(t, cloud, cloud, &pool));
+    for (std::size_t i = 0; i < 10'000; ++i) {
+        const auto want = mat_vec(tm, 4, 4, {before[3 * i], before[3 * i + 1], before[3 * i + 2], 1.0});
+        for (std::size_t k = 0; k < 3; ++k) REQUIRE(std::fabs(pts[3 * i + k] - want[k]) < 1e-12);
+    }
+    REQUIRE(!linalg::transform_cloud(t, {pts.data(), 5000, 6}, cloud));
+}
+
 TEST_CASE(test_planner_reaches_goal){
     Planner p(5,5);
     auto path = p.plan(0,0,4,4);
@@ -31,3 +352,992 @@ TEST_CASE(test_planner_reaches_goal){
         REQUIRE(path.back().second == 4);
     }
 }
+
+TEST_CASE(test_deadline_scheduler_counts_ticks){
+    DeadlineScheduler s(std::chrono::milliseconds(1));
+    s.reset();
+    for (int i = 0; i < 20; ++i) REQUIRE(s.wait_next());
+    REQUIRE(s.stats().ticks() == 20);
+    REQUIRE(s.stats().percentile(0.99) >= s.stats().percentile(0.5));
+    REQUIRE(s.stats().max_jitter() >= s.stats().mean_jitter());
+}
+
+TEST_CASE(test_deadline_scheduler_skip_policy_realigns){
+    DeadlineScheduler s(std::chrono::milliseconds(1), OverrunPolicy::Skip);
+    s.reset();
+    s.wait_next();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5)); // overrun ~4 periods
+    s.wait_next();
+    REQUIRE(s.stats().overruns() == 1);
+    REQUIRE(s.stats().skipped() >= 3);
+    REQUIRE(s.next_deadline() <= std::chrono::steady_clock::now());
+}
+
+TEST_CASE(test_deadline_scheduler_catch_up_runs_missed_ticks){
+    DeadlineScheduler s(std::chrono::milliseconds(1), OverrunPolicy::CatchUp);
+    s.reset();
+    s.wait_next();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    auto before = std::chrono::steady_clock::now();
+    s.wait_next();
+    s.wait_next();
+    // missed deadlines are replayed immediately rather than slept on
+    REQUIRE(std::chrono::steady_clock::now() - before < std::chrono::milliseconds(1));
+    REQUIRE(s.stats().skipped() == 0);
+    REQUIRE(s.stats().overruns() == 2);
+}
+
+TEST_CASE(test_control_loop_stop_is_prompt){
+    Robot robot("r", 2);
+    Planner planner(4,4);
+    ControlLoop loop(robot, planner, {std::chrono::milliseconds(2), OverrunPolicy::Skip});
+    loop.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    loop.stop();
+    REQUIRE(!loop.running());
+    REQUIRE(loop.timing().ticks() > 0);
+    REQUIRE(robot.joints()[0].position > 0.0);
+}
+
+TEST_CASE(test_executor_runs_tasks_at_their_rates){
+    ExecutorOptions opts;
+    opts.workers = 2;
+    opts.cpus = {0};
+    RateMonotonicExecutor ex(opts);
+    std::atomic<int> slow{0}, fast{0};
+    auto slow_id = ex.add_task("slow", std::chrono::milliseconds(20), [&]{ ++slow; });
+    auto fast_id = ex.add_task("fast", std::chrono::milliseconds(2), [&]{ ++fast; });
+    ex.start();
+    REQUIRE(ex.workers().size() == 2);
+    REQUIRE(ex.add_task("late", std::chrono::milliseconds(1), []{}) == RateMonotonicExecutor::npos);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ex.stop();
+    REQUIRE(ex.task_name(slow_id) == "slow");
+    REQUIRE(ex.task_name(fast_id) == "fast");
+    REQUIRE(fast > slow);
+    REQUIRE(slow >= 2);
+    REQUIRE(ex.task_stats(fast_id).ticks() == static_cast<std::uint64_t>(fast.load()));
+}
+
+TEST_CASE(test_executor_counts_deadline_misses){
+    RateMonotonicExecutor ex({1, {}, false, 0});
+    auto id = ex.add_task("hog", std::chrono::milliseconds(1),
+                          []{ std::this_thread::sleep_for(std::chrono::milliseconds(3)); });
+    ex.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    ex.stop();
+    REQUIRE(ex.task_stats(id).overruns() > 0);
+    REQUIRE(ex.task_stats(id).skipped() >= ex.task_stats(id).overruns());
+}
+
+// every step moves to an adjacent free cell
+static bool path_is_valid(const Planner& p, const std::vector<std::pair<int,int>>& path){
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        auto [x, y] = path[i];
+        if (!p.free_cell(x, y)) return false;
+        if (i > 0 && (std::abs(x - path[i-1].first) > 1 || std::abs(y - path[i-1].second) > 1)) return false;
+    }
+    return true;
+}
+
+TEST_CASE(test_astar_reconstructs_full_path){
+    Planner p(5,5);
+    auto path = p.plan(0,0,4,0);
+    REQUIRE(path.size() == 5);
+    REQUIRE(path.front() == std::make_pair(0,0));
+    REQUIRE(path.back() == std::make_pair(4,0));
+    REQUIRE(p.last_stats().cost == 4 * Planner::kStraightCost);
+    REQUIRE(path_is_valid(p, path));
+}
+
+TEST_CASE(test_astar_detours_around_wall){
+    Planner p(7,7);
+    for (int y = 0; y < 6; ++y) p.grid()[y*7 + 3] = 1; // wall with a gap at the bottom
+    auto path = p.plan(0,0,6,0);
+    REQUIRE(path_is_valid(p, path));
+    REQUIRE(path.back() == std::make_pair(6,0));
+    REQUIRE(p.last_stats().cost == (6 + 2*6) * Planner::kStraightCost);
+    p.grid()[6*7 + 3] = 1; // close the gap
+    REQUIRE(p.plan(0,0,6,0).empty());
+    REQUIRE(p.last_stats().cost == -1);
+}
+
+TEST_CASE(test_astar_rejects_blocked_or_out_of_bounds){
+    Planner p(4,4);
+    p.grid()[3*4 + 3] = 1;
+    REQUIRE(p.plan(0,0,3,3).empty());
+    REQUIRE(p.plan(-1,0,2,2).empty());
+    REQUIRE(p.plan(0,0,4,0).empty());
+    REQUIRE(p.plan(1,1,1,1).size() == 1);
+}
+
+TEST_CASE(test_astar_octile_expands_less_than_bfs){
+    Planner p(64,64, {PlannerMode::AStar, Connectivity::Eight});
+    auto path = p.plan(0,0,63,40);
+    REQUIRE(path_is_valid(p, path));
+    REQUIRE(p.last_stats().cost == 40*Planner::kDiagonalCost + 23*Planner::kStraightCost);
+    auto astar_expanded = p.last_stats().expanded;
+    p.set_options({PlannerMode::BFS, Connectivity::Four});
+    p.plan(0,0,63,40);
+    REQUIRE(astar_expanded * 10 < p.last_stats().expanded);
+}
+
+TEST_CASE(test_jps_matches_astar_cost_on_random_maps){
+    std::mt19937 rng(7);
+    for (int trial = 0; trial < 40; ++trial) {
+        Planner p(48,32, {PlannerMode::AStar, Connectivity::Eight});
+        std::bernoulli_distribution wall(0.05 + 0.01 * (trial % 30));
+        for (auto& c : p.grid()) c = wall(rng) ? 1 : 0;
+        p.grid()[0] = 0;
+        p.grid()[31*48 + 47] = 0;
+        auto a = p.plan(0,0,47,31);
+        int astar_cost = p.last_stats().cost;
+        p.set_options({PlannerMode::JPS, Connectivity::Eight});
+        auto j = p.plan(0,0,47,31);
+        REQUIRE(p.last_stats().cost == astar_cost);
+        REQUIRE(a.empty() == j.empty());
+        REQUIRE(path_is_valid(p, j));
+        if (!j.empty()) REQUIRE(j.back() == std::make_pair(47,31));
+    }
+}
+
+TEST_CASE(test_jps_set_cell_invalidates_incrementally){
+    Planner p(40,40, {PlannerMode::JPS, Connectivity::Eight});
+    p.plan(0,20,39,20);
+    REQUIRE(p.last_stats().cost == 39 * Planner::kStraightCost);
+    for (int y = 0; y < 39; ++y) p.set_cell(20, y, 1); // wall, gap at the bottom row
+    auto path = p.plan(0,20,39,20);
+    REQUIRE(path_is_valid(p, path));
+    int jps_cost = p.last_stats().cost;
+    p.set_options({PlannerMode::AStar, Connectivity::Eight});
+    p.plan(0,20,39,20);
+    REQUIRE(p.last_stats().cost == jps_cost);
+    p.set_options({PlannerMode::JPS, Connectivity::Eight});
+    p.set_cell(20, 39, 1);
+    REQUIRE(p.plan(0,20,39,20).empty());
+}
+
+TEST_CASE(test_jps_expands_far_fewer_nodes_on_open_maps){
+    Planner p(200,200, {PlannerMode::AStar, Connectivity::Eight});
+    for (int i = 0; i < 30; ++i) p.set_cell(20 + 5*i, 10 + 6*i, 1); // scattered pillars
+    for (int y = 50; y < 150; ++y) p.set_cell(100, y, 1);
+    p.plan(5,100,195,110);
+    auto astar = p.last_stats();
+    p.set_options({PlannerMode::JPS, Connectivity::Eight});
+    p.plan(5,100,195,110);
+    REQUIRE(p.last_stats().cost == astar.cost);
+    REQUIRE(p.last_stats().expanded * 10 < astar.expanded);
+}
+
+TEST_CASE(test_incremental_planner_matches_astar_after_updates){
+    Planner p(60,60, {PlannerMode::AStar, Connectivity::Eight});
+    Planner ref(60,60, {PlannerMode::AStar, Connectivity::Eight});
+    IncrementalPlanner dstar(p);
+    REQUIRE(dstar.reset(2,30,57,30));
+    auto path = dstar.plan();
+    REQUIRE(path_is_valid(p, path));
+    REQUIRE(dstar.last_stats().cost == 55 * Planner::kStraightCost);
+
+    // robot advances, then lidar marks a short wall just ahead of it
+    dstar.move_start(path[3].first, path[3].second);
+    std::vector<CellChange> scan;
+    for (int y = 28; y <= 32; ++y) scan.push_back({8, y, 1});
+    dstar.update_cells(scan);
+    path = dstar.plan();
+    REQUIRE(path_is_valid(p, path));
+    REQUIRE(path.front() == std::make_pair(5,30));
+    REQUIRE(path.back() == std::make_pair(57,30));
+    ref.grid() = p.grid();
+    ref.plan(5,30,57,30);
+    REQUIRE(dstar.last_stats().cost == ref.last_stats().cost);
+
+    // clearing the wall restores the straight route
+    for (auto& c : scan) c.value = 0;
+    dstar.update_cells(scan);
+    dstar.plan();
+    REQUIRE(dstar.last_stats().cost == 52 * Planner::kStraightCost);
+}
+
+TEST_CASE(test_incremental_planner_repairs_locally_on_cluttered_map){
+    std::mt19937 rng(1);
+    std::bernoulli_distribution wall(0.25);
+    Planner p(100,100, {PlannerMode::AStar, Connectivity::Eight});
+    for (auto& c : p.grid()) c = wall(rng) ? 1 : 0;
+    p.set_cell(0,50,0);
+    p.set_cell(99,50,0);
+    IncrementalPlanner dstar(p);
+    dstar.reset(0,50,99,50);
+    auto path = dstar.plan();
+    REQUIRE(!path.empty());
+    auto initial_expanded = dstar.last_stats().expanded;
+    dstar.move_start(path[2].first, path[2].second);
+    CellChange blocked{path[4].first, path[4].second, 1};
+    dstar.update_cells({&blocked, 1});
+    auto repaired = dstar.plan();
+    REQUIRE(path_is_valid(p, repaired));
+    REQUIRE(dstar.last_stats().expanded * 5 < initial_expanded);
+}
+
+TEST_CASE(test_incremental_planner_reports_unreachable){
+    Planner p(10,10);
+    IncrementalPlanner dstar(p);
+    REQUIRE(!dstar.reset(0,0,10,0));
+    REQUIRE(dstar.reset(0,0,9,9));
+    std::vector<CellChange> wall;
+    for (int x = 0; x < 10; ++x) wall.push_back({x, 5, 1});
+    dstar.update_cells(wall);
+    REQUIRE(dstar.plan().empty());
+    REQUIRE(dstar.last_stats().cost == -1);
+}
+
+TEST_CASE(test_occupancy_grid_neighbors_match_bytes){
+    std::mt19937 rng(11);
+    std::bernoulli_distribution wall(0.3);
+    const int w = 21, h = 13; // not tile multiples: exercises padding
+    std::vector<uint8_t> bytes(w*h);
+    for (auto& c : bytes) c = wall(rng) ? 1 : 0;
+    auto grid = OccupancyGrid::from_bytes(w, h, bytes);
+    std::vector<uint8_t> back;
+    grid.to_bytes(back);
+    REQUIRE(back == bytes);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            unsigned expect = 0;
+            for (int k = 0; k < 8; ++k) {
+                int nx = x + Planner::kSteps[k].dx, ny = y + Planner::kSteps[k].dy;
+                bool blocked = nx < 0 || nx >= w || ny < 0 || ny >= h || bytes[ny*w + nx];
+                if (blocked) expect |= 1u << k;
+            }
+            REQUIRE(grid.blocked_neighbors(x, y) == expect);
+        }
+    }
+    REQUIRE(grid.memory_bytes() * 4 <= bytes.size());
+
+    // reset() clears exactly the words that were set, however sparse
+    BitSet bits;
+    bits.reset(1000);
+    for (std::size_t i : {3u, 64u, 65u, 700u, 999u}) bits.set(i);
+    bits.reset(1000);
+    bool any = false;
+    for (std::size_t i = 0; i < 1000; ++i) any = any || bits.test(i);
+    REQUIRE(!any);
+    bits.set(999);
+    REQUIRE(bits.test(999) && !bits.test(998));
+}
+
+TEST_CASE(test_packed_planner_matches_byte_planner){
+    std::mt19937 rng(5);
+    std::bernoulli_distribution wall(0.2);
+    Planner bytes(90,70, {PlannerMode::AStar, Connectivity::Eight});
+    Planner packed(90,70, {PlannerMode::AStar, Connectivity::Eight, GridStorage::Packed});
+    for (int y = 0; y < 70; ++y)
+        for (int x = 0; x < 90; ++x) {
+            uint8_t v = (x + y > 0 && x + y < 158 && wall(rng)) ? 1 : 0;
+            bytes.set_cell(x, y, v);
+            packed.set_cell(x, y, v);
+        }
+    for (auto conn : {Connectivity::Four, Connectivity::Eight}) {
+        for (auto mode : {PlannerMode::AStar, PlannerMode::JPS}) {
+            bytes.set_options({mode, conn});
+            packed.set_options({mode, conn, GridStorage::Packed});
+            auto a = bytes.plan(0,0,89,69);
+            auto b = packed.plan(0,0,89,69);
+            REQUIRE(bytes.last_stats().cost == packed.last_stats().cost);
+            REQUIRE(path_is_valid(packed, b));
+        }
+    }
+    REQUIRE(packed.memory_bytes() < bytes.memory_bytes());
+
+    // const reads hand out a copy and leave the packed planner untouched
+    const std::size_t packed_bytes = packed.memory_bytes();
+    REQUIRE(std::as_const(packed).grid() == std::as_const(bytes).grid());
+    REQUIRE(packed.memory_bytes() == packed_bytes);
+
+    // legacy writes through grid() are re-packed (and the mirror freed)
+    // before the next plan
+    packed.set_options({PlannerMode::AStar, Connectivity::Four, GridStorage::Packed});
+    for (int y = 0; y < 70; ++y) packed.grid()[y*90 + 45] = 1;
+    REQUIRE(std::as_const(packed).grid()[10*90 + 45] == 1);
+    REQUIRE(packed.plan(0,0,89,69).empty());
+    REQUIRE(packed.memory_bytes() < packed_bytes + 90*70);
+    packed.set_options({PlannerMode::AStar, Connectivity::Four, GridStorage::Bytes});
+    REQUIRE(packed.grid()[10*90 + 45] == 1);
+}
+
+TEST_CASE(test_hierarchical_planner_finds_near_optimal_paths){
+    std::mt19937 rng(21);
+    std::bernoulli_distribution wall(0.15);
+    Planner p(96,96, {PlannerMode::AStar, Connectivity::Eight});
+    for (int y = 0; y < 96; ++y)
+        for (int x = 0; x < 96; ++x) p.set_cell(x, y, wall(rng) ? 1 : 0);
+    p.set_cell(1,1,0);
+    p.set_cell(94,90,0);
+    HierarchicalPlanner hpa(p, 16);
+    auto waypoints = hpa.plan_waypoints(1,1,94,90);
+    REQUIRE(waypoints.size() >= 3);
+    auto path = hpa.plan(1,1,94,90);
+    REQUIRE(path_is_valid(p, path));
+    REQUIRE(path.front() == std::make_pair(1,1));
+    REQUIRE(path.back() == std::make_pair(94,90));
+    int hpa_cost = hpa.last_stats().cost;
+    p.plan(1,1,94,90);
+    REQUIRE(hpa_cost >= p.last_stats().cost);
+    REQUIRE(hpa_cost * 10 <= p.last_stats().cost * 13);
+}
+
+TEST_CASE(test_hierarchical_planner_updates_dirty_sectors_only){
+    Planner p(64,64);
+    HierarchicalPlanner hpa(p, 16);
+    REQUIRE(hpa.sectors_rebuilt() == 16);
+    // wall off column 40 except one gap, all inside sectors x=2
+    std::vector<CellChange> wall;
+    for (int y = 0; y < 64; ++y) if (y != 50) wall.push_back({40, y, 1});
+    hpa.update_cells(wall);
+    auto path = hpa.plan(2,2,60,2);
+    REQUIRE(path_is_valid(p, path));
+    REQUIRE(std::find(path.begin(), path.end(), std::make_pair(40,50)) != path.end());
+    // four dirty sectors; interior column, so no border (and no neighbour) changed
+    REQUIRE(hpa.sectors_rebuilt() == 16 + 4);
+
+    CellChange close_gap{40, 50, 1};
+    hpa.update_cells({&close_gap, 1});
+    REQUIRE(hpa.plan(2,2,60,2).empty());
+    REQUIRE(hpa.last_stats().cost == -1);
+}
+
+TEST_CASE(test_batch_planner_matches_individual_plans){
+    std::mt19937 rng(3);
+    for (auto storage : {GridStorage::Bytes, GridStorage::Packed}) {
+        Planner p(40,30, {PlannerMode::AStar, Connectivity::Eight, storage});
+        std::bernoulli_distribution wall(0.2);
+        for (int y = 0; y < 30; ++y)
+            for (int x = 0; x < 40; ++x) p.set_cell(x, y, wall(rng) ? 1 : 0);
+        std::uniform_int_distribution<int> X(0,39), Y(0,29), G(0,2);
+        const int goals[3][2] = {{5,5},{35,25},{20,15}};
+        std::vector<PlanQuery> qs;
+        for (int i = 0; i < 60; ++i) {
+            const int g = G(rng);
+            // every third query gets a unique goal, the rest share three
+            if (i % 3 == 0) qs.push_back({X(rng), Y(rng), X(rng), Y(rng)});
+            else qs.push_back({X(rng), Y(rng), goals[g][0], goals[g][1]});
+        }
+        qs.push_back({-1, 0, 5, 5});
+
+        std::vector<int> goal_cells;
+        for (const auto& q : qs) goal_cells.push_back(q.gy*40 + q.gx);
+        std::sort(goal_cells.begin(), goal_cells.end());
+        std::size_t groups = 0;
+        for (std::size_t i = 1; i < goal_cells.size(); ++i)
+            if (goal_cells[i] == goal_cells[i-1] && (i == 1 || goal_cells[i-2] != goal_cells[i])) ++groups;
+
+        BatchPlanner batch(p, {4});
+        BatchResult r = batch.plan(qs);
+        REQUIRE(r.spans.size() == qs.size());
+        REQUIRE(batch.last_stats().shared_fields == groups);
+        REQUIRE(batch.last_stats().searches + 2 * groups <= qs.size());
+        for (std::size_t i = 0; i < qs.size(); ++i) {
+            auto expect = p.plan(qs[i].sx, qs[i].sy, qs[i].gx, qs[i].gy);
+            REQUIRE(r.spans[i].cost == p.last_stats().cost);
+            std::vector<std::pair<int,int>> got;
+            for (auto c : r.path(i)) got.push_back(r.xy(c));
+            REQUIRE(got.empty() == expect.empty());
+            REQUIRE(path_is_valid(p, got));
+            if (!got.empty()) {
+                REQUIRE(got.front() == std::make_pair(qs[i].sx, qs[i].sy));
+                REQUIRE(got.back() == std::make_pair(qs[i].gx, qs[i].gy));
+            }
+        }
+    }
+}
+
+TEST_CASE(test_batch_planner_shares_one_field_per_goal){
+    // serpentine corridors: the heuristic misleads A* on every query
+    Planner p(64,64);
+    for (int x = 2; x < 64; x += 4)
+        for (int y = 0; y < 64; ++y)
+            if (y != ((x / 4) % 2 ? 0 : 63)) p.set_cell(x, y, 1);
+    std::vector<PlanQuery> qs;
+    for (int i = 0; i < 32; ++i) qs.push_back({i % 2, i * 2, 63, 63});
+    BatchPlanner batch(p, {2});
+    BatchResult r;
+    batch.plan(qs, r);
+    REQUIRE(batch.last_stats().shared_fields == 1);
+    REQUIRE(batch.last_stats().searches == 0);
+    // one settled field costs less than 32 separate A* searches
+    std::size_t individual = 0;
+    for (const auto& q : qs) {
+        p.plan(q.sx, q.sy, q.gx, q.gy);
+        individual += p.last_stats().expanded;
+        REQUIRE(r.spans[&q - qs.data()].cost == p.last_stats().cost);
+    }
+    REQUIRE(batch.last_stats().expanded < individual);
+    // results are reusable without reallocating
+    const auto cap = r.cells.capacity();
+    batch.plan(qs, r);
+    REQUIRE(r.cells.capacity() == cap);
+}
+
+TEST_CASE(test_flow_field_matches_astar_costs){
+    std::mt19937 rng(11);
+    for (auto conn : {Connectivity::Four, Connectivity::Eight}) {
+        for (auto storage : {GridStorage::Bytes, GridStorage::Packed}) {
+            Planner p(37,29, {PlannerMode::AStar, conn, storage});
+            std::bernoulli_distribution wall(0.25);
+            for (int y = 0; y < 29; ++y)
+                for (int x = 0; x < 37; ++x) p.set_cell(x, y, wall(rng) ? 1 : 0);
+            p.set_cell(18, 14, 0);
+            REQUIRE(p.build_flow_field(18, 14));
+            for (int y = 0; y < 29; ++y) {
+                for (int x = 0; x < 37; ++x) {
+                    p.plan(x, y, 18, 14);
+                    REQUIRE(p.flow_distance(x, y) == p.last_stats().cost);
+                }
+            }
+            p.set_options({PlannerMode::FlowField, conn, storage});
+            for (int i = 0; i < 50; ++i) {
+                const int sx = static_cast<int>(rng() % 37), sy = static_cast<int>(rng() % 29);
+                auto path = p.plan(sx, sy, 18, 14);
+                REQUIRE(path_is_valid(p, path));
+                REQUIRE(path.empty() == (p.flow_distance(sx, sy) < 0));
+                if (!path.empty()) REQUIRE(path.back() == std::make_pair(18,14));
+            }
+        }
+    }
+}
+
+TEST_CASE(test_flow_field_reused_until_map_changes){
+    Planner p(50,50, {PlannerMode::FlowField, Connectivity::Eight});
+    p.plan(0,0,25,25);
+    REQUIRE(p.last_stats().expanded > 0);
+    REQUIRE(p.flow_sweeps() <= 4); // open map converges in one down/up pair plus a check
+    p.plan(49,49,25,25);
+    REQUIRE(p.last_stats().expanded == 0);
+    REQUIRE(p.flow_next(25,25) == std::nullopt);
+    REQUIRE(p.flow_next(24,24) == std::make_pair(25,25));
+
+    for (int y = 0; y < 49; ++y) p.set_cell(30, y, 1);
+    auto path = p.plan(49,0,25,25);
+    REQUIRE(p.last_stats().expanded > 0);
+    REQUIRE(path_is_valid(p, path));
+    REQUIRE(std::find(path.begin(), path.end(), std::make_pair(30,49)) != path.end());
+    REQUIRE(!p.build_flow_field(30, 0));
+    REQUIRE(p.flow_distance(0, 0) == -1);
+}
+
+TEST_CASE(test_sample_ring_latest_batches_and_overwrite){
+    SampleRing ring(6); // rounds up to 8
+    REQUIRE(ring.capacity() == 8);
+    REQUIRE(!ring.latest());
+    auto at = [](int i) { return Sample{Timestamp(std::chrono::microseconds(i)), 0.5 * i}; };
+    for (int i = 0; i < 5; ++i) ring.push(at(i));
+    REQUIRE(ring.latest()->value == 2.0);
+
+    SampleCursor fast, slow;
+    std::array<Sample, 3> buf;
+    REQUIRE(ring.read(fast, buf) == 3);
+    REQUIRE(buf[0].stamp == at(0).stamp && buf[2].value == 1.0);
+    REQUIRE(ring.read(fast, buf) == 2);
+    REQUIRE(ring.read(fast, buf) == 0);
+    REQUIRE(fast.next == 5 && fast.dropped == 0);
+
+    for (int i = 5; i < 20; ++i) ring.push(at(i));
+    // slow never read: only the last 8 survive
+    std::array<Sample, 16> all;
+    REQUIRE(ring.read(slow, all) == 8);
+    REQUIRE(slow.dropped == 12 && all[0].value == 6.0 && all[7].value == 9.5);
+    REQUIRE(ring.read(fast, all) == 8);
+    REQUIRE(fast.dropped == 7);
+}
+
+TEST_CASE(test_sample_ring_concurrent_readers_see_ordered_untorn_samples){
+    SampleRing ring(64);
+    constexpr std::uint64_t kSamples = 200'000;
+    std::atomic<bool> done{false};
+    auto consume = [&](std::size_t batch, std::uint64_t& got, std::uint64_t& dropped, bool& ok) {
+        SampleCursor cur;
+        std::vector<Sample> buf(batch);
+        double last = -1.0;
+        for (;;) {
+            const bool finished = done.load(std::memory_order_acquire);
+            const std::size_t n = ring.read(cur, buf);
+            for (std::size_t i = 0; i < n; ++i) {
+                // value and stamp are written as a pair; a torn read would split them
+                ok = ok && buf[i].value > last &&
+                     buf[i].stamp.time_since_epoch().count() == static_cast<Timestamp::rep>(buf[i].value);
+                last = buf[i].value;
+            }
+            got += n;
+            if (finished && n == 0) break;
+        }
+        dropped = cur.dropped;
+    };
+    std::uint64_t got[2] = {}, dropped[2] = {};
+    bool ok[2] = {true, true};
+    std::thread a(consume, 1, std::ref(got[0]), std::ref(dropped[0]), std::ref(ok[0]));
+    std::thread b(consume, 17, std::ref(got[1]), std::ref(dropped[1]), std::ref(ok[1]));
+    for (std::uint64_t i = 0; i < kSamples; ++i)
+        ring.push({Timestamp(Timestamp::duration(static_cast<Timestamp::rep>(i))), static_cast<double>(i)});
+    done.store(true, std::memory_order_release);
+    a.join();
+    b.join();
+    REQUIRE(ring.published() == kSamples);
+    for (int k = 0; k < 2; ++k) {
+        REQUIRE(ok[k]);
+        REQUIRE(got[k] + dropped[k] == kSamples);
+    }
+    REQUIRE(ring.latest()->value == static_cast<double>(kSamples - 1));
+}
+
+TEST_CASE(test_sensor_stream_publishes_timestamped_reads){
+    RandomWalkSensor walk;
+    SensorStream stream(walk, 16);
+    SampleCursor cur;
+    std::array<Sample, 16> buf;
+    for (int i = 0; i < 10; ++i) stream.poll();
+    REQUIRE(stream.samples().read(cur, buf) == 10);
+    for (int i = 1; i < 10; ++i) {
+        REQUIRE(buf[i].stamp >= buf[i - 1].stamp);
+        REQUIRE(std::fabs(buf[i].value - buf[i - 1].value) <= 0.05);
+    }
+    REQUIRE(stream.samples().latest()->value == buf[9].value);
+}
+
+TEST_CASE(test_counter_rng_batches_match_single_draws){
+    // Random123 known answer for Philox4x32-10, counter 0, key 0
+    REQUIRE(CounterRng::bits(0, 0) == ((std::uint64_t{0x6627e8d5} << 20) ^ (0xe169c58du >> 12)));
+    REQUIRE(CounterRng::bits(0, 1) == ((std::uint64_t{0xbc57ac4c} << 20) ^ (0x9b00dbd8u >> 12)));
+    CounterRng single(7), batched(7);
+    std::vector<double> want(1001), got(1001);
+    for (auto& v : want) v = single.uniform(-2.0, 3.0);
+    // odd split points exercise the half-block head and tail
+    std::size_t at = 0;
+    for (std::size_t len : {1u, 2u, 5u, 64u, 129u, 800u}) {
+        batched.uniform(std::span(got).subspan(at, len), -2.0, 3.0);
+        at += len;
+    }
+    REQUIRE(at == got.size() && batched.counter() == single.counter());
+    REQUIRE(got == want);
+    REQUIRE(*std::min_element(got.begin(), got.end()) >= -2.0);
+    REQUIRE(*std::max_element(got.begin(), got.end()) < 3.0);
+}
+
+TEST_CASE(test_sensor_read_batch_matches_models){
+    using namespace std::chrono_literals;
+    RandomWalkSensor single(2ms), batched(2ms);
+    std::array<double, 100> values;
+    std::array<Timestamp, 100> stamps;
+    REQUIRE(batched.read_batch(values, std::span(stamps).first(40)) == 40);
+    REQUIRE(batched.read_batch(std::span(values).subspan(40), std::span(stamps).subspan(40)) == 60);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(values[i] == single.read()); // same counter stream, same accumulation
+        if (i > 0) REQUIRE(stamps[i] - stamps[i - 1] == 2ms); // second batch continues the first
+    }
+
+    NoisySineSensor sine(3.0, 500us);
+    REQUIRE(sine.read_batch(values, stamps) == 100);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const double t = std::chrono::duration<double>(stamps[i].time_since_epoch()).count();
+        REQUIRE(std::fabs(values[i] - std::sin(3.0 * t)) <= 0.01 + 1e-6);
+    }
+
+    // the SensorBase default goes through read()
+    struct Counting : SensorBase {
+        double n = 0;
+        const char* name() const override { return "Counting"; }
+        double read() override { return ++n; }
+    } counting;
+    REQUIRE(counting.read_batch(values, std::span(stamps).first(3)) == 3);
+    REQUIRE(values[2] == 3.0 && stamps[2] >= stamps[0]);
+
+    SensorStream stream(sine, 256);
+    REQUIRE(stream.poll(150) == 150);
+    REQUIRE(stream.samples().published() == 150);
+}
+
+TEST_CASE(test_virtual_clock_scheduler_jumps_to_deadlines){
+    using namespace std::chrono_literals;
+    VirtualClock vc(Timestamp(5s));
+    DeadlineScheduler sched(10ms, OverrunPolicy::Skip, vc);
+    sched.reset();
+    for (int i = 0; i < 100; ++i) REQUIRE(sched.wait_next());
+    REQUIRE(vc.now() == Timestamp(5s + 1s));
+    REQUIRE(sched.stats().ticks() == 100 && sched.stats().max_jitter() == 0ns);
+    vc.advance(35ms); // body "ran long"
+    REQUIRE(sched.wait_next());
+    REQUIRE(sched.stats().overruns() == 1 && sched.stats().skipped() == 3);
+    vc.advance_to(Timestamp(1s)); // never backwards
+    REQUIRE(vc.now() == Timestamp(5s + 1s + 40ms));
+}
+
+TEST_CASE(test_simulated_control_loop_is_deterministic_and_fast){
+    using namespace std::chrono_literals;
+    struct Run {
+        std::vector<Sample> samples;
+        std::vector<double> joints;
+        std::uint64_t ticks{}, task_runs{};
+    };
+    auto scenario = [](std::uint64_t seed) {
+        VirtualClock vc;
+        Robot robot("sim_bot", 3, vc);
+        robot.add_sensor(new NoisySineSensor(2.0, 1ms, seed));
+        robot.add_sensor(new RandomWalkSensor(1ms, seed + 1));
+        Planner planner(10, 10);
+        ControlLoop loop(robot, planner, {.period = 10ms});
+        std::vector<std::unique_ptr<SensorStream>> streams;
+        for (auto* s : robot.sensors()) {
+            streams.push_back(std::make_unique<SensorStream>(*s, 1 << 14));
+            loop.add_task(s->name(), 1ms, [st = streams.back().get()] { st->poll(); });
+        }
+        loop.add_task("batch", 50ms, [st = streams[1].get()] { st->poll(8); });
+        Run r;
+        r.ticks = loop.simulate(10s);
+        REQUIRE(vc.now() == Timestamp(10s));
+        for (std::size_t t = 0; t < loop.tasks().task_count(); ++t) r.task_runs += loop.tasks().task_stats(t).ticks();
+        for (const auto& st : streams) {
+            SampleCursor cur;
+            std::vector<Sample> buf(st->samples().capacity());
+            buf.resize(st->samples().read(cur, buf));
+            REQUIRE(cur.dropped == 0);
+            r.samples.insert(r.samples.end(), buf.begin(), buf.end());
+        }
+        for (double q : robot.joints().positions()) r.joints.push_back(q);
+        return r;
+    };
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const Run a = scenario(7);
+    const auto wall = std::chrono::steady_clock::now() - t0;
+    const Run b = scenario(7), c = scenario(8);
+    REQUIRE(a.ticks == 1000 && a.task_runs == 10'000 + 10'000 + 200);
+    REQUIRE(a.samples.size() == 10'000 + 10'000 + 200 * 8);
+    REQUIRE(a.samples.front().stamp == Timestamp(1ms));
+    auto same = [](const Run& x, const Run& y) {
+        if (x.samples.size() != y.samples.size() || x.joints != y.joints) return false;
+        for (std::size_t i = 0; i < x.samples.size(); ++i)
+            if (x.samples[i].stamp != y.samples[i].stamp || x.samples[i].value != y.samples[i].value) return false;
+        return true;
+    };
+    REQUIRE(same(a, b));
+    REQUIRE(!same(a, c));
+    REQUIRE(wall < 1s); // 10 s of scenario; typically a few ms
+}
+
+TEST_CASE(test_log_records_interned_ids_and_raw_args){
+    std::vector<log::Record> records;
+    log::set_sink([](const log::Record& r, void* ctx) { static_cast<std::vector<log::Record>*>(ctx)->push_back(r); },
+                  &records);
+    int evaluated = 0;
+    ROBOKIT_LOG_DEBUG("debug {}", ++evaluated); // compiled out below DEBUG: argument not evaluated
+    const std::string who = "arm";
+    for (int i = 0; i < 2; ++i)
+        ROBOKIT_LOG_INFO("{} moved {} joints by {} rad {{ok={}}}", who, i + 2, 0.25, true);
+    ROBOKIT_LOG_ERROR("fault {} at {} in {}", 'E', 42u, "wrist"); // a literal argument too
+    log::warn("legacy runtime message");
+    log::set_sink(nullptr);
+
+    REQUIRE(evaluated == (log::enabled(log::Level::Debug) ? 1 : 0));
+    const std::size_t expected = (log::enabled(log::Level::Debug) ? 1 : 0) + (log::enabled(log::Level::Info) ? 2 : 0) +
+                                 (log::enabled(log::Level::Warn) ? 1 : 0) + (log::enabled(log::Level::Error) ? 1 : 0);
+    REQUIRE(records.size() == expected);
+    if (log::kMinLevel == log::Level::Info) { // default build: the two infos, the error, the warning
+        REQUIRE(records[0].id == records[1].id); // one site, interned once
+        REQUIRE(records[2].id != records[0].id);
+        const log::Site& site = log::site(records[0].id);
+        REQUIRE(std::string_view(site.format) == "{} moved {} joints by {} rad {{ok={}}}");
+        REQUIRE(site.level == log::Level::Info && site.line > 0);
+        REQUIRE(records[1].arg_count == 4 && records[1].types[1] == log::ArgType::Int && records[1].args[1].i == 3);
+        REQUIRE(log::format(records[0]) == "arm moved 2 joints by 0.25 rad {ok=true}");
+        REQUIRE(log::format(records[2]) == "fault E at 42 in wrist");
+        REQUIRE(records[2].level == log::Level::Error);
+        REQUIRE(log::format(records[3]) == "legacy runtime message");
+    }
+
+    // strings share a fixed text area and are truncated, never overflowed
+    log::Record r;
+    const std::string big(200, 'x');
+    log::detail::pack(r, std::string_view(big));
+    log::detail::pack(r, std::string_view("tail"));
+    REQUIRE(r.text_size == log::Record::kTextBytes && r.args[0].s.size == log::Record::kTextBytes && r.args[1].s.size == 0);
+    REQUIRE(r.truncated);
+
+    // the "..." goes on the argument that was cut, not the one that filled the area
+    log::Record exact;
+    exact.id = log::intern(log::Level::Info, "{}|{}|{}", __FILE__, __LINE__);
+    log::detail::pack(exact, std::string_view(big).substr(0, log::Record::kTextBytes));
+    log::detail::pack(exact, std::string_view("lost"));
+    log::detail::pack(exact, 7);
+    REQUIRE(log::format(exact) == std::string(log::Record::kTextBytes, 'x') + "|...|7");
+
+    // long legacy messages reach a custom sink flagged and marked as cut
+    records.clear();
+    log::set_sink([](const log::Record& rec, void* ctx) { static_cast<std::vector<log::Record>*>(ctx)->push_back(rec); },
+                  &records);
+    log::error(std::string(300, 'y'));
+    log::set_sink(nullptr);
+    if (log::enabled(log::Level::Error)) {
+        REQUIRE(records.size() == 1 && records[0].truncated);
+        REQUIRE(log::format(records[0]) == std::string(log::Record::kTextBytes, 'y') + "...");
+    }
+}
+
+TEST_CASE(test_telemetry_roundtrip_index_and_replay){
+    using namespace std::chrono_literals;
+    const std::string path = (std::filesystem::temp_directory_path() / "robokit_test_telemetry.bin").string();
+    VirtualClock vc;
+    Robot robot("rec_bot", 3, vc);
+    robot.add_sensor(new NoisySineSensor(1.0));
+    robot.add_sensor(new RandomWalkSensor());
+    Planner planner(10, 10);
+    std::vector<double> values(2), recorded;
+    {
+        // tiny blocks and reserve: 1000 frames span many index segments and regrow the file
+        TelemetryWriter writer;
+        REQUIRE(writer.open(path, robot, {.frames_per_block = 5, .blocks_per_index = 4, .reserve_frames = 16}));
+        ControlLoop loop(robot, planner, {.period = 1ms});
+        loop.add_task("record", 1ms, [&] {
+            for (std::size_t c = 0; c < 2; ++c) values[c] = robot.sensors()[c]->read();
+            recorded.push_back(values[1]);
+            REQUIRE(writer.record(vc.now(), robot, values));
+        });
+        REQUIRE(loop.simulate(1s) == 1000);
+        REQUIRE(writer.frames() == 1000);
+        REQUIRE(!writer.record(Timestamp(5ms), robot, values)); // out of order
+        REQUIRE(!writer.append(vc.now(), std::vector<double>(2), std::vector<double>(3), values)); // wrong dof
+    }
+
+    TelemetryReader log;
+    REQUIRE(log.open(path));
+    REQUIRE(log.frames() == 1000 && log.dof() == 3 && log.channel_count() == 2);
+    REQUIRE(log.channel_name(0) == "NoisySine" && log.channel_name(1) == "RandomWalk");
+    REQUIRE(log.stamp(0) == Timestamp(1ms) && log.stamp(999) == Timestamp(1000ms));
+    JointStore js(3);
+    log.read_joints(499, js); // recorded after the 500th tick
+    REQUIRE(std::fabs(js.positions()[2] - 500 * 0.01) < 1e-9);
+    for (std::uint64_t f = 0; f < 1000; f += 37) REQUIRE(log.value(f, 1) == recorded[f]);
+    REQUIRE(log.upper_bound(Timestamp{}) == 0);
+    REQUIRE(log.upper_bound(Timestamp(1ms)) == 1);
+    REQUIRE(log.upper_bound(Timestamp(733ms) + 500us) == 733);
+    REQUIRE(log.upper_bound(Timestamp(5s)) == 1000);
+    REQUIRE(log.block_count() == 125); // 5 rounds up to 8 frames per block
+    const auto blk = log.block(13);
+    REQUIRE(blk.size() == 8 && blk.stamps[0] == Timestamp(105ms).time_since_epoch().count());
+    REQUIRE(blk.channel(1)[3] == recorded[13 * 8 + 3] && blk.positions(0)[0] == log.block(13).positions(1)[0]);
+
+    // replay: the control body reproduces each next frame; sensors play the recording back
+    VirtualClock rc;
+    Robot replayed("replay_bot", 3, rc);
+    for (std::size_t c = 0; c < 2; ++c) replayed.add_sensor(new ReplaySensor(log, c));
+    ControlLoop loop(replayed, planner, {.period = 1ms});
+    std::vector<double> seen;
+    loop.add_task("sensor", 1ms, [&] { seen.push_back(replayed.sensors()[1]->read()); });
+    double worst = 0;
+    REQUIRE(loop.replay(log, [&](std::uint64_t f) {
+        if (f + 1 == log.frames()) return;
+        log.read_joints(f + 1, js);
+        for (std::size_t j = 0; j < 3; ++j) worst = std::max(worst, std::fabs(replayed.joints()[j].position - js[j].position));
+    }) == 1000);
+    REQUIRE(worst < 1e-12);
+    REQUIRE(seen.size() == 1000 && seen == recorded);
+    log.close();
+
+    // damaged files: header fields are untrusted, frames are limited to what the file holds
+    auto poke = [&](std::streamoff offset, auto value) {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(offset);
+        f.write(reinterpret_cast<const char*>(&value), sizeof value);
+    };
+    const auto full_size = std::filesystem::file_size(path);
+    poke(24, ~std::uint64_t{0}); // frame count
+    REQUIRE(log.open(path) && log.frames() == 1000 && log.stamp(999) == Timestamp(1000ms));
+    log.close();
+    std::filesystem::resize_file(path, full_size / 2); // cut mid-file: whole blocks only
+    REQUIRE(log.open(path) && log.frames() > 0 && log.frames() < 1000 && log.frames() % 8 == 0);
+    REQUIRE(log.upper_bound(Timestamp(5s)) == log.frames());
+    log.close();
+    std::filesystem::resize_file(path, 4096 + 100); // header only, yet frames claimed
+    REQUIRE(!log.open(path));
+    std::filesystem::resize_file(path, full_size);
+    poke(8, ~std::uint32_t{0}); // dof: multi-GB blocks
+    REQUIRE(!log.open(path));
+    poke(8, std::uint32_t{3});
+    poke(16, std::uint32_t{0xFFFFFFF8u}); // frames per block
+    REQUIRE(!log.open(path));
+    std::filesystem::resize_file(path, 100);
+    REQUIRE(!log.open(path));
+    std::filesystem::remove(path);
+}
+
+TEST_CASE(test_joint_store_is_aligned_soa_and_drives_the_loop){
+    JointStore js(13);
+    for (auto field : {js.positions(), js.velocities(), js.efforts(), js.lower_limits(), js.upper_limits()}) {
+        REQUIRE(field.size() == 13);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(field.data()) % 64 == 0);
+    }
+    REQUIRE(std::isinf(js.lower_limits()[12]) && js.lower_limits()[12] < 0 && std::isinf(js.upper_limits()[0]));
+    js.set(4, {0.5, -1.0});
+    js.efforts()[12] = 3.0;
+    const JointStore copy = js; // re-aligned, same contents
+    REQUIRE(reinterpret_cast<std::uintptr_t>(copy.positions().data()) % 64 == 0);
+    REQUIRE(copy[4].position == 0.5 && copy[4].velocity == -1.0 && copy.efforts()[12] == 3.0);
+    REQUIRE(std::isinf(copy.upper_limits()[12]));
+
+    // the control body clamps to the limits; kinematics reads the positions in place
+    using namespace std::chrono_literals;
+    VirtualClock vc;
+    Robot robot("soa_bot", 64, vc);
+    robot.joints().upper_limits()[1] = 0.05;
+    Planner planner(4, 4);
+    ControlLoop loop(robot, planner, {.period = 1ms});
+    REQUIRE(loop.simulate(10ms) == 10);
+    REQUIRE(std::fabs(robot.joints()[0].position - 0.1) < 1e-12 && robot.joints()[1].position == 0.05);
+    const auto q = robot.joints().positions();
+    const auto pose = Kinematics::forward(q);
+    REQUIRE(pose.x == Kinematics::forward(std::vector<double>(q.begin(), q.end())).x);
+}
+
+TEST_CASE(test_state_publisher_readers_never_see_torn_snapshots){
+    constexpr std::size_t dof = 64;
+    StatePublisher pub(dof);
+    RobotState s;
+    REQUIRE(!pub.read(s) && pub.published() == 0);
+
+    // every publish writes one value k everywhere; a torn read would mix two
+    std::atomic<bool> done{false};
+    std::atomic<std::uint64_t> bad{0}, reads{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            RobotState snap;
+            std::uint64_t last = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                if (!pub.read(snap)) continue;
+                const double k = static_cast<double>(snap.sequence);
+                for (std::size_t j = 0; j < dof; ++j)
+                    if (snap.joints.positions()[j] != k || snap.joints.velocities()[j] != -k || snap.joints.efforts()[j] != 2 * k)
+                        bad.fetch_add(1);
+                if (snap.sequence < last || snap.stamp != Timestamp(std::chrono::microseconds(snap.sequence))) bad.fetch_add(1);
+                last = snap.sequence;
+                reads.fetch_add(1);
+            }
+        });
+    }
+    JointStore js(dof);
+    for (std::uint64_t k = 1; k <= 20000; ++k) {
+        std::fill(js.positions().begin(), js.positions().end(), static_cast<double>(k));
+        std::fill(js.velocities().begin(), js.velocities().end(), -static_cast<double>(k));
+        std::fill(js.efforts().begin(), js.efforts().end(), 2.0 * static_cast<double>(k));
+        pub.publish(Timestamp(std::chrono::microseconds(k)), js);
+        if (k % 1000 == 0) std::this_thread::yield();
+    }
+    done = true;
+    for (auto& t : readers) t.join();
+    REQUIRE(bad == 0 && reads > 0);
+    REQUIRE(pub.read(s) && s.sequence == 20000 && s.joints.positions()[63] == 20000.0);
+
+    // the control loop publishes after each tick
+    using namespace std::chrono_literals;
+    VirtualClock vc;
+    Robot robot("pub_bot", 3, vc);
+    Planner planner(4, 4);
+    ControlLoop loop(robot, planner, {.period = 1ms});
+    REQUIRE(loop.simulate(5ms) == 5);
+    REQUIRE(robot.state().read(s) && s.sequence == 5 && s.stamp == Timestamp(5ms));
+    REQUIRE(s.joints.size() == 3 && s.joints.positions()[2] == robot.joints()[2].position);
+}
+
+TEST_CASE(test_config_loads_in_place_with_typed_numbers){
+    Config cfg;
+    REQUIRE(!cfg.load_string("# gains\r\narm.kp = 12.5\r\n\r\narm.name=left arm \r\nbroken line\r\narm.kp=13\r\nlimit=1e-3\r\nbad=1.5x\r\n=7\r\n"));
+    REQUIRE(cfg.error_line() == 5 && cfg.size() == 4);
+    REQUIRE(cfg.get_number("arm.kp") == 13.0); // last one wins
+    REQUIRE(cfg.get_number("limit") == 1e-3);
+    REQUIRE(cfg.get_number("bad", -1.0) == -1.0 && cfg.get_view("bad") == "1.5x");
+    REQUIRE(cfg.get_string("arm.name") == "left arm" && cfg.get_number("arm.name", 2.0) == 2.0);
+    REQUIRE(!cfg.contains("missing") && cfg.get_number(std::string("missing"), 4.0) == 4.0);
+
+    // the number forms std::stod took; only whole values count
+    Config nums;
+    REQUIRE(nums.load_string("a=+0.5\nb=0x10\nc=-0X1p4\nd=-2e2\ne=+-1\nf=0x\ng=0x-1\nh=1e999\ni=+"));
+    REQUIRE(nums.get_number("a") == 0.5 && nums.get_number("b") == 16.0 && nums.get_number("c") == -16.0);
+    REQUIRE(nums.get_number("d") == -200.0);
+    for (const char* k : {"e", "f", "g", "h", "i"}) REQUIRE(nums.get_number(k, 9.0) == 9.0);
+
+    // movable (e.g. out of a factory): the views follow the text; loads replace
+    auto make = [] {
+        Config c;
+        c.load_string("k=1\nname=short");
+        return c;
+    };
+    Config moved = make();
+    REQUIRE(moved.get_number("k") == 1.0 && moved.get_view("name") == "short");
+    moved = std::move(cfg);
+    REQUIRE(moved.size() == 4 && moved.get_number("limit") == 1e-3 && cfg.size() == 0 && !cfg.contains("limit"));
+    REQUIRE(moved.load_string("other=2") && moved.size() == 1 && !moved.contains("limit"));
+
+    // a few MB from disk: mapped, tokenized and converted once
+    const std::string path = (std::filesystem::temp_directory_path() / "robokit_test_config.cfg").string();
+    {
+        std::ofstream out(path, std::ios::binary);
+        for (int i = 0; i < 100'000; ++i) out << "joint" << i << ".gain = " << i * 0.5 << "\n# note\nlabel" << i << "=x\n";
+    }
+    REQUIRE(cfg.load_file(path));
+    REQUIRE(cfg.size() == 200'000 && cfg.error_line() == 0 && !cfg.contains("arm.kp"));
+    REQUIRE(cfg.get_number("joint99999.gain") == 99999 * 0.5 && cfg.get_view("label7") == "x");
+    REQUIRE(!cfg.load_file(path + ".missing") && cfg.size() == 0);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE(test_async_logger_batches_per_thread_rings){
+    struct Collected {
+        std::vector<log::Record> records;
+        std::size_t batches{0};
+        std::atomic<bool> entered{false}, release{true};
+    } got;
+    auto collect = [](std::span<const log::Record> batch, void* ctx) {
+        auto* c = static_cast<Collected*>(ctx);
+        c->entered = true;
+        while (!c->release) std::this_thread::yield();
+        c->records.insert(c->records.end(), batch.begin(), batch.end());
+        ++c->batches;
+    };
+    constexpr int kThreads = 3, kEach = 500;
+    {
+        log::AsyncLogger logger({.ring_records = 1024, .batch_records = 64, .sink = collect, .context = &got});
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t)
+            threads.emplace_back([t] {
+                for (int i = 0; i < kEach; ++i) ROBOKIT_LOG_INFO("thread {} record {}", t, i);
+            });
+        for (auto& th : threads) th.join();
+        logger.flush();
+        if (log::enabled(log::Level::Info)) {
+            REQUIRE(got.records.size() == kThreads * kEach && logger.delivered() == kThreads * kEach);
+            REQUIRE(logger.dropped() == 0 && logger.threads() == kThreads && got.batches >= kThreads * kEach / 64);
+            // each thread's records arrive in the order it logged them
+            std::array<std::int64_t, kThreads> next{};
+            for (const auto& r : got.records) REQUIRE(r.args[1].i == next[static_cast<std::size_t>(r.args[0].i)]++);
+            REQUIRE(log::format(got.records.back()).starts_with("thread "));
+        }
+    }
+    REQUIRE(got.records.size() == (log::enabled(log::Level::Info) ? kThreads * kEach : 0));
+
+    // a full ring drops instead of waiting for a stalled sink
+    got.records.clear();
+    got.entered = false;
+    got.release = false;
+    std::uint64_t dropped = 0;
+    {
+        log::AsyncLogger logger({.ring_records = 4, .sink = collect, .context = &got});
+        log::error("first");
+        if (log::enabled(log::Level::Error)) {
+            while (!got.entered) std::this_thread::yield(); // the backend is now stuck in the sink
+            for (int i = 0; i < 10; ++i) log::error("queued or dropped");
+            dropped = logger.dropped();
+        }
+        got.release = true;
+    } // destruction delivers what was queued
+    if (log::enabled(log::Level::Error)) {
+        REQUIRE(dropped == 6 && got.records.size() == 5);
+        REQUIRE(log::format(got.records.front()) == "first");
+    }
+}